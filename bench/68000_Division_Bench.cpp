@@ -0,0 +1,389 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define M68K_BENCH_PERF 1
+#endif
+
+#include "68000.h"
+#include "68000_Dividers.h"
+#include "68000_Native.h"
+#include "68000_Pool.h"
+
+// Measures the microcode interpreter on workloads that take different paths through the microcode.
+// Build with and without M68K_THREADED_DISPATCH to compare the dispatch methods.
+//
+// Latency runs each division on a result of the previous one, throughput runs them independently.
+// Where perf_event_open is available the branch misses per division and the instructions per
+// emulated microcycle (one microword, 2 clock cycles) are reported too.
+//
+//     68000_Division_Bench [divisions per workload]
+
+namespace {
+
+struct Operands {
+    uint32_t dividend;
+    uint16_t divisor;
+};
+
+struct Random {
+    uint32_t state{0x1234'5678u};
+
+    auto Next() -> uint32_t {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    }
+
+    // Nonzero and below 0x8000 so the divisor is positive for DIVS too
+    auto Divisor() -> uint16_t {
+        return 1u + (Next() >> 16u) % 0x7FFFu;
+    }
+};
+
+// Every quotient bit is 0, so every iteration of the main loop restores the remainder
+auto AllRestore(Random& random, bool) -> Operands {
+    const auto divisor = random.Divisor();
+    return { random.Next() % divisor, divisor };
+}
+
+// Every quotient bit is 1, apart from the sign for DIVS, so no iteration of the main loop restores the remainder
+auto NoRestore(Random& random, bool isSigned) -> Operands {
+    const auto divisor = random.Divisor();
+    return { divisor * (isSigned ? 0x7FFFu : 0xFFFFu) + random.Next() % divisor, divisor };
+}
+
+// The upper word of the dividend isn't below the divisor, DVUM4 for DIVU and DVUMZ for DIVS
+auto Overflow(Random& random, bool) -> Operands {
+    const auto divisor = random.Divisor();
+    return { (static_cast<uint32_t>(divisor) << 16u) | (random.Next() >> 16u), divisor };
+}
+
+// TRAP0
+auto DivideByZero(Random& random, bool) -> Operands {
+    return { random.Next(), 0u };
+}
+
+auto RandomOperands(Random& random, bool) -> Operands {
+    const auto dividend = random.Next();
+    return { dividend, static_cast<uint16_t>(random.Next() >> 16u) };
+}
+
+struct Workload {
+    const char* name;
+    Operands (*make)(Random&, bool isSigned);
+};
+
+constexpr Workload WORKLOADS[] = {
+    { "all-restore", AllRestore },
+    { "no-restore", NoRestore },
+    { "overflow", Overflow },
+    { "divide-by-zero", DivideByZero },
+    { "random", RandomOperands },
+};
+
+auto MakeOperands(const Workload& workload, bool isSigned, std::size_t count) -> std::vector<Operands> {
+    Random random;
+    std::vector<Operands> operands(count);
+    for (auto& o : operands) {
+        o = workload.make(random, isSigned);
+    }
+    return operands;
+}
+
+#if M68K_BENCH_PERF
+// Instructions and branch misses of this thread, read as one group
+class PerfCounters {
+public:
+    PerfCounters() {
+        leader = Open(PERF_COUNT_HW_INSTRUCTIONS, -1);
+        if (leader >= 0) {
+            branchMisses = Open(PERF_COUNT_HW_BRANCH_MISSES, leader);
+        }
+        if (branchMisses < 0 && leader >= 0) {
+            close(leader);
+            leader = -1;
+        }
+    }
+
+    ~PerfCounters() {
+        if (branchMisses >= 0) {
+            close(branchMisses);
+        }
+        if (leader >= 0) {
+            close(leader);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+
+    auto Available() const -> bool { return leader >= 0; }
+
+    auto Start() -> void {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    // Returns false if the counters couldn't be read
+    auto Stop(uint64_t& instructions, uint64_t& misses) -> bool {
+        ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t values[3]{}; // Number of counters, instructions, branch misses
+        if (read(leader, values, sizeof(values)) != sizeof(values) || values[0] != 2u) {
+            return false;
+        }
+        instructions = values[1];
+        misses = values[2];
+        return true;
+    }
+
+private:
+    static auto Open(uint64_t config, int group) -> int {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = (group < 0) ? 1u : 0u;
+        attr.exclude_kernel = 1u;
+        attr.exclude_hv = 1u;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+
+    int leader{-1};
+    int branchMisses{-1};
+};
+#else
+// perf_event_open isn't available on this platform
+class PerfCounters {
+public:
+    auto Available() const -> bool { return false; }
+    auto Start() -> void {}
+    auto Stop(uint64_t&, uint64_t&) -> bool { return false; }
+};
+#endif
+
+struct Measurement {
+    double nanoseconds{}; // Per division
+    uint64_t microcycles{};
+    bool counted{};
+    uint64_t instructions{};
+    uint64_t branchMisses{};
+};
+
+// Read once per run so the compiler can't drop the dependency between divisions in the latency runs
+volatile uint32_t chainMask = 0u;
+// Written after the bulk runs so the compiler can't drop their divisions
+volatile uint64_t totalCycles = 0u;
+
+template<bool Signed, bool Dependent>
+auto Measure(const std::vector<Operands>& operands, PerfCounters& counters) -> Measurement {
+    Measurement measurement;
+    const auto mask = chainMask;
+    auto chain = 0u;
+    auto cycles = uint64_t{};
+    if (counters.Available()) {
+        counters.Start();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& [dividend, divisor] : operands) {
+        auto mc68000 = LoadDivision(Dependent ? dividend ^ chain : dividend, divisor);
+        if constexpr (Signed) {
+            mc68000.ExecuteDivs();
+        } else {
+            mc68000.ExecuteDivu();
+        }
+        chain = (mc68000.rxdl + mc68000.cycles) & mask;
+        cycles += mc68000.cycles;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (counters.Available()) {
+        measurement.counted = counters.Stop(measurement.instructions, measurement.branchMisses);
+    }
+    measurement.nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(operands.size());
+    measurement.microcycles = cycles / 2u;
+    return measurement;
+}
+
+template<bool Signed>
+auto Report(const char* instruction, const Workload& workload, const std::vector<Operands>& operands, PerfCounters& counters) -> void {
+    const auto latency = Measure<Signed, true>(operands, counters);
+    const auto throughput = Measure<Signed, false>(operands, counters);
+    std::cout << std::left << std::setw(6) << instruction << std::setw(16) << workload.name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << latency.nanoseconds
+              << std::setw(10) << throughput.nanoseconds
+              << std::setw(14) << static_cast<uint64_t>(1e9 / throughput.nanoseconds);
+    if (throughput.counted) {
+        std::cout << std::setw(14) << static_cast<double>(throughput.branchMisses) / static_cast<double>(operands.size())
+                  << std::setw(14) << static_cast<double>(throughput.instructions) / static_cast<double>(throughput.microcycles);
+    }
+    std::cout << std::endl;
+}
+
+// Random operands, alternately DIVU and DIVS, run in bulk from a pool of contexts
+auto MeasurePool(std::size_t count) -> double {
+    const auto operands = MakeOperands({ "random", RandomOperands }, false, count);
+    MC68000Pool pool(count);
+    for (std::size_t i = 0u; i < count; ++i) {
+        if (i & 1u) {
+            pool.SetDivs(i, operands[i].dividend, operands[i].divisor);
+        } else {
+            pool.SetDivu(i, operands[i].dividend, operands[i].divisor);
+        }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    pool.Execute();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+
+// Random operands, alternately DIVU and DIVS, through a DualModeDivision
+auto MeasureDualMode(std::size_t count, DivisionMode mode, uint32_t sampleInterval) -> double {
+    const auto operands = MakeOperands({ "random", RandomOperands }, false, count);
+    DualModeDivision division(mode, sampleInterval);
+    auto cycles = uint64_t{};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < count; ++i) {
+        auto mc68000 = LoadDivision(operands[i].dividend, operands[i].divisor);
+        (i & 1u) ? division.Divs(mc68000) : division.Divu(mc68000);
+        cycles += mc68000.cycles;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    totalCycles = cycles;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+// The workload, alternately DIVU and DIVS, with the main loop unrolled or run microword by microword
+auto MeasureFused(const Workload& workload, std::size_t count, bool fused) -> double {
+    const auto operands = MakeOperands(workload, false, count);
+    auto cycles = uint64_t{};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < count; ++i) {
+        auto mc68000 = LoadDivision(operands[i].dividend, operands[i].divisor);
+        if (fused) {
+            (i & 1u) ? mc68000.ExecuteDivsFused() : mc68000.ExecuteDivuFused();
+        } else {
+            (i & 1u) ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+        }
+        cycles += mc68000.cycles;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    totalCycles = cycles;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+// Random operands, alternately DIVU and DIVS, run in slices of maxCycles as a scheduler interleaving devices would
+auto MeasureResumable(std::size_t count, uint32_t maxCycles) -> double {
+    const auto operands = MakeOperands({ "random", RandomOperands }, false, count);
+    auto cycles = uint64_t{};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < count; ++i) {
+        auto mc68000 = LoadDivision(operands[i].dividend, operands[i].divisor);
+        if (i & 1u) {
+            mc68000.microword = DVS01;
+            while (!mc68000.RunDivs(maxCycles)) {}
+        } else {
+            mc68000.microword = DVUR1;
+            while (!mc68000.RunDivu(maxCycles)) {}
+        }
+        cycles += mc68000.cycles;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    totalCycles = cycles;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+// The workload, alternately DIVU and DIVS, on one of the what-if dividers, also gives the mean emulated cycles
+auto MeasureModel(const Workload& workload, std::size_t count, DividerModel model, double& meanCycles) -> double {
+    const auto operands = MakeOperands(workload, false, count);
+    auto cycles = uint64_t{};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < count; ++i) {
+        auto mc68000 = LoadDivision(operands[i].dividend, operands[i].divisor);
+        ExecuteDivision(model, (i & 1u) ? DivisionInstruction::Divs : DivisionInstruction::Divu, mc68000);
+        cycles += mc68000.cycles;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    totalCycles = cycles;
+    meanCycles = static_cast<double>(cycles) / static_cast<double>(count);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    auto count = std::size_t{1u} << 22u;
+    if (argc > 1) {
+        count = std::strtoull(argv[1], nullptr, 0);
+        if (count == 0u) {
+            std::cerr << "Usage: " << argv[0] << " [divisions per workload]" << std::endl;
+            return 2;
+        }
+    }
+
+#if M68K_THREADED_DISPATCH
+    std::cout << "Dispatch: threaded" << std::endl;
+#else
+    std::cout << "Dispatch: switch" << std::endl;
+#endif
+    PerfCounters counters;
+    if (!counters.Available()) {
+        std::cout << "Hardware counters: unavailable" << std::endl;
+    }
+    std::cout << "Divisions per workload: " << count << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(6) << "" << std::setw(16) << "workload" << std::right
+              << std::setw(10) << "lat ns" << std::setw(10) << "tput ns" << std::setw(14) << "divisions/s";
+    if (counters.Available()) {
+        std::cout << std::setw(14) << "br-miss/div" << std::setw(14) << "insn/ucycle";
+    }
+    std::cout << std::endl;
+
+    for (const auto& workload : WORKLOADS) {
+        Report<false>("DIVU", workload, MakeOperands(workload, false, count), counters);
+        Report<true>("DIVS", workload, MakeOperands(workload, true, count), counters);
+    }
+
+    const auto pool = MeasurePool(count);
+    std::cout << std::endl << "Pool, random DIVU/DIVS: " << pool << " ns/division, "
+              << static_cast<uint64_t>(1e9 / pool) << " divisions/s" << std::endl;
+
+    for (const auto& [name, mode, sampleInterval] : {
+             std::tuple{ "microcode", DivisionMode::Microcode, 0u },
+             std::tuple{ "native", DivisionMode::Native, 0u },
+             std::tuple{ "native, 1/1024 verified", DivisionMode::Native, 1024u },
+         }) {
+        const auto nanoseconds = MeasureDualMode(count, mode, sampleInterval);
+        std::cout << "Dual mode " << name << ", random DIVU/DIVS: " << nanoseconds << " ns/division, "
+                  << static_cast<uint64_t>(1e9 / nanoseconds) << " divisions/s" << std::endl;
+    }
+    for (const auto maxCycles : { 2u, 16u, 1'000u }) {
+        const auto nanoseconds = MeasureResumable(count, maxCycles);
+        std::cout << "Resumable, slices of " << maxCycles << " cycles, random DIVU/DIVS: " << nanoseconds
+                  << " ns/division" << std::endl;
+    }
+    for (const auto& workload : { WORKLOADS[0], WORKLOADS[1], WORKLOADS[4] }) {
+        for (const auto fused : { false, true }) {
+            std::cout << (fused ? "Fused loop, " : "Microword loop, ") << workload.name << " DIVU/DIVS: "
+                      << MeasureFused(workload, count, fused) << " ns/division" << std::endl;
+        }
+    }
+    for (const auto& workload : { WORKLOADS[0], WORKLOADS[4] }) {
+        for (const auto model : DIVIDER_MODELS) {
+            auto meanCycles = 0.0;
+            const auto nanoseconds = MeasureModel(workload, count, model, meanCycles);
+            std::cout << "Divider " << DividerModelName(model) << ", " << workload.name << " DIVU/DIVS: " << nanoseconds
+                      << " ns/division, " << meanCycles << " emulated cycles/division" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -4,63 +4,86 @@
 
 // DIVU microword labels
 
-constexpr auto DVUR1 = 1u;
-constexpr auto DVUM2 = 2u;
-constexpr auto DVUM3 = 3u;
-constexpr auto DVUM4 = 4u;
-constexpr auto DVUM5 = 5u;
-constexpr auto DVUM6 = 6u;
-constexpr auto DVUM7 = 7u;
-constexpr auto DVUM8 = 8u;
-constexpr auto DVUM9 = 9u;
-constexpr auto DVUMA = 10u;
-constexpr auto DVUMB = 11u;
-constexpr auto DVUMC = 12u;
-constexpr auto DVUMD = 13u;
-constexpr auto DVUME = 14u;
-constexpr auto DVUMF = 15u;
-constexpr auto DVUM0 = 16u;
-constexpr auto DVUMZ = 20u;
+constexpr auto DVUR1 = 0u;
+constexpr auto DVUM2 = 1u;
+constexpr auto DVUM3 = 2u;
+constexpr auto DVUM4 = 3u;
+constexpr auto DVUM5 = 4u;
+constexpr auto DVUM6 = 5u;
+constexpr auto DVUM7 = 6u;
+constexpr auto DVUM8 = 7u;
+constexpr auto DVUM9 = 8u;
+constexpr auto DVUMA = 9u;
+constexpr auto DVUMB = 10u;
+constexpr auto DVUMC = 11u;
+constexpr auto DVUMD = 12u;
+constexpr auto DVUME = 13u;
+constexpr auto DVUMF = 14u;
+constexpr auto DVUM0 = 15u;
+constexpr auto DVUMZ = 16u;
 
 
 // DIVS microword labels
-constexpr auto DVS01 = 101u; // Note the patent says signed division stars with DVS02 but that reads from the data bus
-constexpr auto DVS03 = 103u;
-constexpr auto DVS04 = 104u;
-constexpr auto DVS05 = 105u;
-constexpr auto DVS06 = 106u;
-constexpr auto DVS07 = 107u;
-constexpr auto DVS08 = 108u;
-constexpr auto DVS09 = 109u;
-constexpr auto DVS0A = 110u;
-constexpr auto DVS0C = 112u;
-constexpr auto DVS0D = 113u;
-constexpr auto DVS0E = 114u;
-constexpr auto DVS0F = 115u;
-constexpr auto DVS10 = 116u;
-constexpr auto DVS11 = 117u;
-constexpr auto DVS12 = 118u;
-constexpr auto DVS13 = 119u;
-constexpr auto DVS14 = 120u;
-constexpr auto DVS15 = 121u;
-constexpr auto DVS16 = 122u;
-constexpr auto DVS17 = 123u;
-constexpr auto DVS1A = 126u;
-constexpr auto DVS1B = 127u;
-constexpr auto DVS1C = 128u;
-constexpr auto DVS1D = 129u;
-constexpr auto DVS1E = 130u;
-constexpr auto DVS1F = 131u;
-constexpr auto DVS20 = 132u;
+constexpr auto DVS01 = 17u; // Note the patent says signed division stars with DVS02 but that reads from the data bus
+constexpr auto DVS03 = 18u;
+constexpr auto DVS04 = 19u;
+constexpr auto DVS05 = 20u;
+constexpr auto DVS06 = 21u;
+constexpr auto DVS07 = 22u;
+constexpr auto DVS08 = 23u;
+constexpr auto DVS09 = 24u;
+constexpr auto DVS0A = 25u;
+constexpr auto DVS0C = 26u;
+constexpr auto DVS0D = 27u;
+constexpr auto DVS0E = 28u;
+constexpr auto DVS0F = 29u;
+constexpr auto DVS10 = 30u;
+constexpr auto DVS11 = 31u;
+constexpr auto DVS12 = 32u;
+constexpr auto DVS13 = 33u;
+constexpr auto DVS14 = 34u;
+constexpr auto DVS15 = 35u;
+constexpr auto DVS16 = 36u;
+constexpr auto DVS17 = 37u;
+constexpr auto DVS1A = 38u;
+constexpr auto DVS1B = 39u;
+constexpr auto DVS1C = 40u;
+constexpr auto DVS1D = 41u;
+constexpr auto DVS1E = 42u;
+constexpr auto DVS1F = 43u;
+constexpr auto DVS20 = 44u;
 
 // LEA microword
-constexpr auto LEAA2 = 200u;
+constexpr auto LEAA2 = 45u;
 
 // TRAP microword labels
-constexpr auto TRAP0 = 300u;
+constexpr auto TRAP0 = 46u;
 
 // A1, A2, A3 instruction microword labels
-constexpr auto A1 = 400u;
+constexpr auto A1 = 47u;
+
+// MULU/MULS microword labels, the two instructions share them and branch on bit 8 of the instruction.
+// They follow A1 so the labels of the division microwords keep their numbers
+constexpr auto MULR1 = 48u;
+constexpr auto MULM2 = 49u;
+constexpr auto MULM3 = 50u;
+constexpr auto MULM4 = 51u;
+constexpr auto MULM5 = 52u;
+constexpr auto MULM6 = 53u;
+
+// Microword labels are numbered densely from zero so they can index dispatch tables
+constexpr auto MICROWORD_COUNT = 54u;
+
+// Microword label names, indexed by microword label
+constexpr const char* MICROWORD_NAMES[MICROWORD_COUNT] = {
+    "DVUR1", "DVUM2", "DVUM3", "DVUM4", "DVUM5", "DVUM6", "DVUM7", "DVUM8",
+    "DVUM9", "DVUMA", "DVUMB", "DVUMC", "DVUMD", "DVUME", "DVUMF", "DVUM0",
+    "DVUMZ", "DVS01", "DVS03", "DVS04", "DVS05", "DVS06", "DVS07", "DVS08",
+    "DVS09", "DVS0A", "DVS0C", "DVS0D", "DVS0E", "DVS0F", "DVS10", "DVS11",
+    "DVS12", "DVS13", "DVS14", "DVS15", "DVS16", "DVS17", "DVS1A", "DVS1B",
+    "DVS1C", "DVS1D", "DVS1E", "DVS1F", "DVS20", "LEAA2", "TRAP0", "A1",
+    "MULR1", "MULM2", "MULM3", "MULM4", "MULM5", "MULM6",
+};
 
 // Processor flags
 constexpr auto FLAG_X = 0x10u;
@@ -69,6 +92,52 @@ constexpr auto FLAG_Z = 0x04u;
 constexpr auto FLAG_V = 0x02u;
 constexpr auto FLAG_C = 0x01u;
 
+#if M68K_LAZY_FLAGS
+// With M68K_LAZY_FLAGS the ALU operations only record the operands and result of the last AND or SUB,
+// and the flags are worked out from them one bit at a time as a branch tests them.
+// AND keeps X from before it, so only X of the previous operation is worked out when an AND is done.
+enum class FlagsOperation : uint8_t {
+    None, // flags is up to date
+    And,
+    Sub,
+};
+
+// The flags after a pending operation, oldFlags & FLAG_C works out C only
+struct LazyFlags {
+    uint16_t flags; // Up to date with None, only X with And, unused with Sub
+    uint16_t dst;
+    uint16_t src;
+    uint16_t result;
+    FlagsOperation operation;
+
+    constexpr auto operator&(uint32_t mask) const -> uint16_t {
+        auto value = 0u;
+        switch (operation) {
+            case FlagsOperation::None:
+                return flags & mask;
+            case FlagsOperation::And:
+                value = flags & FLAG_X;
+                break;
+            case FlagsOperation::Sub:
+                value |= (mask & (FLAG_X | FLAG_C)) && dst < src ? FLAG_X | FLAG_C : 0u; // Borrow
+                value |= (mask & FLAG_V) && ((dst ^ src) & (dst ^ result) & 0x8000u) ? FLAG_V : 0u;
+                break;
+        }
+        value |= (mask & FLAG_N) && (result & 0x8000u) ? FLAG_N : 0u;
+        value |= (mask & FLAG_Z) && result == 0u ? FLAG_Z : 0u;
+        return static_cast<uint16_t>(value & mask);
+    }
+
+    constexpr operator uint16_t() const {
+        return *this & (FLAG_X | FLAG_N | FLAG_Z | FLAG_V | FLAG_C);
+    }
+};
+
+using ConditionCodes = LazyFlags;
+#else
+using ConditionCodes = uint16_t;
+#endif
+
 struct MC68000 {
     uint16_t microword{};
 
@@ -82,7 +151,14 @@ struct MC68000 {
     uint16_t alub{}; // Alu buffer
 
     uint16_t alu{}; // Alu
-    uint16_t flags{}; // Flags
+    uint16_t flags{}; // Flags, with M68K_LAZY_FLAGS only up to date outside the execute functions
+
+#if M68K_LAZY_FLAGS
+    uint16_t flagsDst{}; // Operands and result of the operation whose flags are pending
+    uint16_t flagsSrc{};
+    uint16_t flagsResult{};
+    FlagsOperation flagsOperation{};
+#endif
 
     uint32_t au{}; // Arithmetic unit
 
@@ -91,14 +167,150 @@ struct MC68000 {
 
     uint32_t cycles {};
 
-    auto AluOp_AND(uint16_t, uint16_t) -> uint16_t;
-    auto AluOp_SUB(uint16_t, uint16_t) -> uint16_t;
-    auto AluOp_SUBX(uint16_t, uint16_t) -> uint16_t;
-    auto AluOp_SLAAx(uint16_t) -> uint16_t;
+    // The alu operations return the flags from before the operation,
+    // they are constexpr so the microcode can be evaluated at compile time
+#if M68K_LAZY_FLAGS
+    constexpr auto Flags() const -> ConditionCodes {
+        return { flags, flagsDst, flagsSrc, flagsResult, flagsOperation };
+    }
+
+    // Brings flags up to date, needed before flags is read or written directly
+    constexpr auto SyncFlags() -> void {
+        flags = Flags();
+        flagsOperation = FlagsOperation::None;
+    }
+
+    constexpr auto AluOp_AND(uint16_t dst, uint16_t src) -> ConditionCodes {
+        const auto oldFlags = Flags();
+        alu = dst & src;
+        flags = oldFlags & FLAG_X;
+        flagsResult = alu;
+        flagsOperation = FlagsOperation::And;
+        return oldFlags;
+    }
+
+    constexpr auto AluOp_SUB(uint16_t dst, uint16_t src) -> ConditionCodes {
+        const auto oldFlags = Flags();
+        alu = dst - src;
+        flagsDst = dst;
+        flagsSrc = src;
+        flagsResult = alu;
+        flagsOperation = FlagsOperation::Sub;
+        return oldFlags;
+    }
+#else
+    constexpr auto Flags() const -> ConditionCodes {
+        return flags;
+    }
+
+    constexpr auto SyncFlags() -> void {}
+
+    constexpr auto AluOp_AND(uint16_t dst, uint16_t src) -> ConditionCodes {
+        const auto oldFlags = flags;
+        alu = dst & src;
+        flags &= FLAG_X;
+        flags |= (alu & 0x8000u) ? FLAG_N : 0u;
+        flags |= (alu == 0u) ? FLAG_Z : 0u;
+        return oldFlags;
+    }
+
+    constexpr auto AluOp_SUB(uint16_t dst, uint16_t src) -> ConditionCodes {
+        const auto oldFlags = flags;
+        alu = dst - src;
+        const auto overflow = (dst ^ src) & (dst ^ alu);
+        const auto carry = (dst ^ src) ^ alu ^ overflow;
+        flags = 0u;
+        flags |= (carry & 0x8000u) ? FLAG_X : 0u;
+        flags |= (alu & 0x8000u) ? FLAG_N : 0u;
+        flags |= (alu == 0u) ? FLAG_Z : 0u;
+        flags |= (overflow & 0x8000u) ? FLAG_V : 0u;
+        flags |= (carry & 0x8000u) ? FLAG_C : 0u;
+        return oldFlags;
+    }
+#endif
+
+    constexpr auto AluOp_SUBX(uint16_t dst, uint16_t src) -> ConditionCodes {
+        alu = dst - src - ((Flags() & FLAG_X) >> 4u);
+        return Flags();
+    }
+
+    constexpr auto AluOp_SLAAx(uint16_t leastSignificantBit) -> ConditionCodes {
+        alu <<= 1u;
+        alu += (alue >> 15u) & 1u;
+        alue <<= 1u;
+        alue += leastSignificantBit;
+        return Flags();
+    }
+
+    // Shifts alu:alue right, the multiplication loop shifts the product out of alu into alue
+    constexpr auto AluOp_SRAx(uint16_t mostSignificantBit) -> ConditionCodes {
+        alue >>= 1u;
+        alue |= (alu & 1u) << 15u;
+        alu >>= 1u;
+        alu |= mostSignificantBit << 15u;
+        return Flags();
+    }
 
     auto Print() const -> void;
 
+    // The trace sink receives the processor state at points of interest in the main loop,
+    // see 68000_Trace.h for the available sinks
+    template<typename TraceSink> auto ExecuteDivu(TraceSink&) -> void;
+    template<typename TraceSink> auto ExecuteDivs(TraceSink&) -> void;
+
     auto ExecuteDivu() -> void;
     auto ExecuteDivs() -> void;
 
-};
\ No newline at end of file
+    // Resumable DIVU and DIVS for interleaving with other devices at microcycle granularity.
+    // Set microword to DVUR1 or DVS01 to start an instruction, then each call runs from microword until
+    // the instruction exits (returns true) or maxCycles have passed, leaving microword at the next one to run.
+    // The exits take no cycles so they always run. A trace sink sees no branch into the first microword of a call
+    template<typename TraceSink> auto RunDivu(TraceSink&, uint32_t maxCycles) -> bool;
+    template<typename TraceSink> auto RunDivs(TraceSink&, uint32_t maxCycles) -> bool;
+
+    auto RunDivu(uint32_t maxCycles) -> bool;
+    auto RunDivs(uint32_t maxCycles) -> bool;
+
+    // DIVU and DIVS with the 16 iterations of the main loop unrolled into straight line code, one block per
+    // iteration in place of its 2 to 4 microwords. The results and cycles are those of ExecuteDivu and ExecuteDivs,
+    // and a sink with Record sees the same records. Sinks with Step or Microcycle run the microwords one by one
+    template<typename TraceSink> auto ExecuteDivuFused(TraceSink&) -> void;
+    template<typename TraceSink> auto ExecuteDivsFused(TraceSink&) -> void;
+
+    auto ExecuteDivuFused() -> void;
+    auto ExecuteDivsFused() -> void;
+
+    // The main loops from microword, stopping at deadline with Budgeted, running the loop fused with Fused
+    template<bool Budgeted, bool Fused, typename TraceSink> auto ContinueDivu(TraceSink&, uint32_t deadline) -> bool;
+    template<bool Budgeted, bool Fused, typename TraceSink> auto ContinueDivs(TraceSink&, uint32_t deadline) -> bool;
+
+    // Multiply rxdl by rydl into rxdh:rxdl, see 68000_Mul.cpp
+    template<typename TraceSink> auto ExecuteMulu(TraceSink&) -> void;
+    template<typename TraceSink> auto ExecuteMuls(TraceSink&) -> void;
+
+    auto ExecuteMulu() -> void;
+    auto ExecuteMuls() -> void;
+
+    // The microwords shared by MULU and MULS, Muls stands for bit 8 of the instruction
+    template<bool Muls, typename TraceSink> auto ExecuteMul(TraceSink&) -> void;
+
+    // Native 32/16 division with the cycles looked up in the generated tables, see 68000_Native.h.
+    // Only rxdh, rxdl, flags, cycles and the exit microword match the microcode, the internal registers are untouched
+    auto ExecuteDivuNative() -> void;
+    auto ExecuteDivsNative() -> void;
+
+    // Runs the microcode ROM generated from the patent listing from the given microword,
+    // ExecuteRom(DVUR1) and ExecuteRom(DVS01) behave like ExecuteDivu and ExecuteDivs.
+    // Defined in 68000_Rom.h, which must be included to call it, and usable in constant expressions
+    constexpr auto ExecuteRom(uint16_t entry) -> void;
+
+};
+
+// A processor with the dividend in Dx and the divisor in the low word of Dy, ready for ExecuteDivu or ExecuteDivs
+constexpr auto LoadDivision(uint32_t dividend, uint16_t divisor) -> MC68000 {
+    MC68000 mc68000;
+    mc68000.rxdh = dividend >> 16u;
+    mc68000.rxdl = dividend;
+    mc68000.rydl = divisor;
+    return mc68000;
+}
@@ -0,0 +1,329 @@
+#include <cstddef>
+#include <stdexcept>
+
+#include "68000.h"
+#include "68000_Batch.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define M68K_BATCH_VECTOR 1
+#if defined(__x86_64__) || defined(__i386__)
+#define M68K_BATCH_X86 1
+#endif
+#endif
+
+namespace {
+
+template<bool Signed>
+auto RunScalar(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    for (std::size_t i = 0u; i < operands.dividends.size(); ++i) {
+        auto mc68000 = LoadDivision(operands.dividends[i], operands.divisors[i]);
+        if constexpr (Signed) {
+            mc68000.ExecuteDivs();
+        } else {
+            mc68000.ExecuteDivu();
+        }
+        results.remainders[i] = mc68000.rxdh;
+        results.quotients[i] = mc68000.rxdl;
+        results.flags[i] = mc68000.flags;
+        results.cycles[i] = mc68000.cycles;
+    }
+}
+
+#if M68K_BATCH_VECTOR
+
+/*
+ * The lane engines hold every register in a 32-bit lane and keep 16-bit values masked to 16 bits.
+ * Comparisons produce all ones or all zeros in each lane, which Select uses in place of a branch.
+ * They're always inlined so that each caller compiles them for its own instruction set,
+ * which also means the vector ABI warnings don't apply.
+ */
+
+#if !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+typedef uint32_t Vector4 __attribute__((vector_size(16)));
+typedef uint32_t Vector8 __attribute__((vector_size(32)));
+typedef uint32_t Vector16 __attribute__((vector_size(64)));
+
+template<typename V>
+struct LaneAlu {
+    V alu;
+    V flags;
+};
+
+template<typename V, typename M>
+[[gnu::always_inline]] inline auto AsMask(M mask) -> V {
+    return (V) mask;
+}
+
+template<typename V>
+[[gnu::always_inline]] inline auto Select(V mask, V a, V b) -> V {
+    return (a & mask) | (b & ~mask);
+}
+
+template<typename V>
+[[gnu::always_inline]] inline auto FlagsNZ(V alu) -> V {
+    return ((alu >> 12u) & FLAG_N) | (AsMask<V>(alu == 0u) & FLAG_Z);
+}
+
+// Lane equivalent of MC68000::AluOp_SUB
+template<typename V>
+[[gnu::always_inline]] inline auto Sub(V dst, V src) -> LaneAlu<V> {
+    const V alu = (dst - src) & 0xFFFFu;
+    const V overflow = (dst ^ src) & (dst ^ alu);
+    const V carry = (dst ^ src) ^ alu ^ overflow;
+    return {
+        alu,
+        ((carry >> 11u) & FLAG_X) | FlagsNZ(alu) | ((overflow >> 14u) & FLAG_V) | ((carry >> 15u) & FLAG_C)
+    };
+}
+
+template<typename V>
+[[gnu::always_inline]] inline auto DivuLanes(V dividend, V divisor, V& remainder, V& quotient, V& flags, V& cycles) -> void {
+    const V high = dividend >> 16u;
+    const V low = dividend & 0xFFFFu;
+    const V zero = AsMask<V>(divisor == 0u); // DVUM2 -> TRAP0
+    const V overflow = ~zero & AsMask<V>(high >= divisor); // DVUM3 -> DVUM4
+
+    // The main loop runs in every lane, the exits discard its results
+    V alu = high;
+    V alue = low;
+    V bit{};
+    V loopCycles{};
+    for (auto i = 0u; i < 16u; ++i) {
+        // DVUM5/6, the N flag is the msb of the remainder about to be shifted out
+        const V msb = AsMask<V>((alu & 0x8000u) != 0u);
+        alu = ((alu << 1u) | (alue >> 15u)) & 0xFFFFu;
+        alue = ((alue << 1u) | bit) & 0xFFFFu;
+        // DVUM7/8
+        const V atl = alu;
+        const V borrow = AsMask<V>(alu < divisor);
+        // DVUMB, DVUME, restore unless the msb was shifted out
+        const V restore = ~msb & borrow;
+        alu = Select(restore, atl, (alu - divisor) & 0xFFFFu);
+        bit = ~restore & 1u;
+        if (i < 15u) {
+            loopCycles += Select(msb, V{}, Select(borrow, V{} + 4u, V{} + 2u));
+        }
+    }
+    // DVUM9/C, DVUMD/F, DVUM0
+    const V result = ((alue << 1u) | bit) & 0xFFFFu;
+
+    const V exit = zero | overflow;
+    remainder = Select(exit, high, alu);
+    quotient = Select(exit, low, result);
+    flags = Select(exit, ((high >> 12u) & FLAG_N) | (zero & AsMask<V>(high == 0u) & FLAG_Z), FlagsNZ(result));
+    cycles = Select(zero, V{} + 2u * 2u, Select(overflow, V{} + 5u * 2u, loopCycles + 38u * 2u));
+}
+
+template<typename V>
+[[gnu::always_inline]] inline auto DivsLanes(V dividend, V divisor, V& remainder, V& quotient, V& flags, V& cycles) -> void {
+    const V high = dividend >> 16u;
+    const V low = dividend & 0xFFFFu;
+    const V zero = AsMask<V>(divisor == 0u); // DVS03 -> TRAP0
+    const V negativeDivisor = AsMask<V>((divisor & 0x8000u) != 0u);
+    const V negativeDividend = AsMask<V>((high & 0x8000u) != 0u);
+    const V absDivisor = Select(negativeDivisor, (0u - divisor) & 0xFFFFu, divisor); // DVS05
+    const V absDividend = Select(negativeDividend, 0u - dividend, dividend); // DVS06, DVS10
+    const V absHigh = absDividend >> 16u;
+    const V earlyOverflow = ~zero & AsMask<V>(absHigh >= absDivisor); // DVS08 -> DVUMZ
+    const V prologueCycles = Select(negativeDividend, V{} + 7u * 2u, V{} + 6u * 2u);
+
+    // The main loop runs in every lane, the exits discard its results
+    V alu = absHigh;
+    V alue = absDividend & 0xFFFFu;
+    V bit{};
+    V borrow{};
+    V loopCycles{};
+    for (auto i = 0u; i < 16u; ++i) {
+        // DVS09/A
+        alu = ((alu << 1u) | (alue >> 15u)) & 0xFFFFu;
+        alue = ((alue << 1u) | bit) & 0xFFFFu;
+        // DVS0C
+        const V atl = alu;
+        borrow = AsMask<V>(alu < absDivisor);
+        // DVS0D, DVS0F
+        alu = Select(borrow, atl, (alu - absDivisor) & 0xFFFFu);
+        bit = ~borrow & 1u;
+        if (i < 15u) {
+            loopCycles += Select(borrow, V{} + 4u, V{} + 2u);
+        }
+    }
+    // DVS0E, DVS12/13, DVS14, the X flag is the borrow of the last DVS0C
+    const V absRemainder = alu;
+    const V absQuotient = ((alue << 1u) | bit) & 0xFFFFu;
+    const V extend = borrow & FLAG_X;
+
+    // Sign correction
+    //     positive divisor, positive dividend: DVS15, DVS16, DVS17
+    //     positive divisor, negative dividend: DVS15, DVS16, DVS1A, DVS1B, DVS1C
+    //     negative divisor, negative dividend: DVS15, DVS1D, DVS1E, DVS1C
+    //     negative divisor, positive dividend: DVS15, DVS1D, DVS1F, DVS20
+    const auto [negatedQuotient, negatedQuotientFlags] = Sub(V{}, absQuotient); // DVS1A, DVS1F
+    const auto [negatedRemainder, negatedRemainderFlags] = Sub(V{}, absRemainder); // DVS1B, DVS1E
+    const V opposingSigns = negativeDivisor ^ negativeDividend;
+    const V lateOverflow = Select(
+        opposingSigns,
+        AsMask<V>((negatedQuotientFlags & (FLAG_N | FLAG_Z)) == 0u),
+        AsMask<V>((absQuotient & 0x8000u) != 0u));
+    const V signedQuotient = Select(opposingSigns, negatedQuotient, absQuotient);
+    const V signedRemainder = Select(negativeDividend, negatedRemainder, absRemainder);
+    const V signedFlags = Select(
+        negativeDividend,
+        Select(lateOverflow, negatedRemainderFlags, (negatedRemainderFlags & FLAG_X) | FlagsNZ(signedQuotient)),
+        Select(negativeDivisor, (negatedQuotientFlags & FLAG_X) | FlagsNZ(negatedQuotient), extend | FlagsNZ(absQuotient)));
+    const V epilogueCycles = Select(
+        negativeDivisor,
+        V{} + 5u * 2u,
+        Select(negativeDividend, V{} + 6u * 2u, V{} + 4u * 2u));
+
+    const V exit = zero | earlyOverflow | lateOverflow;
+    remainder = Select(exit, high, signedRemainder);
+    quotient = Select(exit, low, signedQuotient);
+    flags = Select(zero, V{} + FLAG_Z, Select(earlyOverflow, (absHigh >> 12u) & FLAG_N, signedFlags));
+    cycles = Select(
+        zero,
+        V{} + 2u * 2u,
+        prologueCycles + Select(earlyOverflow, V{} + 2u * 2u, loopCycles + 35u * 2u + epilogueCycles));
+}
+
+template<typename V, bool Signed>
+[[gnu::always_inline]] inline auto RunBlock(const DivisionOperands& operands, const DivisionResults& results, std::size_t i, std::size_t count) -> void {
+    V dividend{};
+    V divisor{};
+    for (std::size_t j = 0u; j < count; ++j) {
+        dividend[j] = operands.dividends[i + j];
+        divisor[j] = operands.divisors[i + j];
+    }
+    V remainder, quotient, flags, cycles;
+    if constexpr (Signed) {
+        DivsLanes(dividend, divisor, remainder, quotient, flags, cycles);
+    } else {
+        DivuLanes(dividend, divisor, remainder, quotient, flags, cycles);
+    }
+    for (std::size_t j = 0u; j < count; ++j) {
+        results.remainders[i + j] = remainder[j];
+        results.quotients[i + j] = quotient[j];
+        results.flags[i + j] = flags[j];
+        results.cycles[i + j] = cycles[j];
+    }
+}
+
+template<typename V, bool Signed>
+[[gnu::always_inline]] inline auto RunVector(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    constexpr auto lanes = sizeof(V) / sizeof(uint32_t);
+    const auto size = operands.dividends.size();
+    auto i = std::size_t{};
+    for (; i + lanes <= size; i += lanes) {
+        RunBlock<V, Signed>(operands, results, i, lanes);
+    }
+    if (i < size) {
+        // The unused lanes divide by zero, which takes the shortest path
+        RunBlock<V, Signed>(operands, results, i, size - i);
+    }
+}
+
+template<bool Signed>
+auto RunVector128(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    RunVector<Vector4, Signed>(operands, results);
+}
+
+#if M68K_BATCH_X86
+
+template<bool Signed>
+[[gnu::target("avx2")]] auto RunAvx2(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    RunVector<Vector8, Signed>(operands, results);
+}
+
+template<bool Signed>
+[[gnu::target("avx512f")]] auto RunAvx512(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    RunVector<Vector16, Signed>(operands, results);
+}
+
+#endif
+
+#endif
+
+template<bool Signed>
+auto Run(const DivisionOperands& operands, const DivisionResults& results, BatchIsa isa) -> void {
+    CheckBatchSpans(operands, results);
+    if (!BatchIsaSupported(isa)) {
+        isa = BatchIsa::Scalar;
+    }
+    switch (isa) {
+#if M68K_BATCH_VECTOR
+        case BatchIsa::Vector128:
+            RunVector128<Signed>(operands, results);
+            return;
+#endif
+#if M68K_BATCH_X86
+        case BatchIsa::Avx2:
+            RunAvx2<Signed>(operands, results);
+            return;
+        case BatchIsa::Avx512:
+            RunAvx512<Signed>(operands, results);
+            return;
+#endif
+        default:
+            RunScalar<Signed>(operands, results);
+            return;
+    }
+}
+
+}
+
+auto CheckBatchSpans(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    const auto size = operands.dividends.size();
+    if (operands.divisors.size() < size || results.remainders.size() < size || results.quotients.size() < size ||
+        results.flags.size() < size || results.cycles.size() < size) {
+        throw std::invalid_argument("Division batch span shorter than the dividends");
+    }
+}
+
+auto BatchIsaSupported(BatchIsa isa) -> bool {
+    switch (isa) {
+        case BatchIsa::Scalar:
+            return true;
+#if M68K_BATCH_VECTOR
+        case BatchIsa::Vector128:
+            return true;
+#endif
+#if M68K_BATCH_X86
+        case BatchIsa::Avx2:
+            return __builtin_cpu_supports("avx2");
+        case BatchIsa::Avx512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+auto BestBatchIsa() -> BatchIsa {
+    static const auto best = [] {
+        for (const auto isa : { BatchIsa::Avx512, BatchIsa::Avx2, BatchIsa::Vector128 }) {
+            if (BatchIsaSupported(isa)) {
+                return isa;
+            }
+        }
+        return BatchIsa::Scalar;
+    }();
+    return best;
+}
+
+auto ExecuteDivuBatch(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    Run<false>(operands, results, BestBatchIsa());
+}
+
+auto ExecuteDivsBatch(const DivisionOperands& operands, const DivisionResults& results) -> void {
+    Run<true>(operands, results, BestBatchIsa());
+}
+
+auto ExecuteDivuBatch(const DivisionOperands& operands, const DivisionResults& results, BatchIsa isa) -> void {
+    Run<false>(operands, results, isa);
+}
+
+auto ExecuteDivsBatch(const DivisionOperands& operands, const DivisionResults& results, BatchIsa isa) -> void {
+    Run<true>(operands, results, isa);
+}
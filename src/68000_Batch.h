@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Batches of divisions in structure-of-arrays form.
+//
+// Each result holds what an MC68000 would after ExecuteDivu/ExecuteDivs with the dividend in rxdh:rxdl
+// and the divisor in rydl: remainder (rxdh), quotient (rxdl), flags and cycles (counted from zero).
+// The batch runs over dividends, every other span must hold at least as many elements. The batch functions
+// throw std::invalid_argument before writing anything when one is shorter.
+//
+// The vector engines run one division per lane, following the restore/subtract decisions of the
+// microcode with masks, and produce exactly the same results as the microcode.
+
+struct DivisionOperands {
+    std::span<const uint32_t> dividends;
+    std::span<const uint16_t> divisors;
+};
+
+struct DivisionResults {
+    std::span<uint16_t> remainders;
+    std::span<uint16_t> quotients;
+    std::span<uint16_t> flags;
+    std::span<uint32_t> cycles;
+};
+
+enum class DivisionInstruction {
+    Divu,
+    Divs,
+};
+
+enum class BatchIsa {
+    Scalar, // One MC68000 per division
+    Vector128, // 4 lanes, SSE2 on x86
+    Avx2, // 8 lanes
+    Avx512, // 16 lanes
+};
+
+// Throws std::invalid_argument when a span is shorter than dividends
+auto CheckBatchSpans(const DivisionOperands&, const DivisionResults&) -> void;
+
+auto BatchIsaSupported(BatchIsa) -> bool;
+auto BestBatchIsa() -> BatchIsa;
+
+// Use the widest engine supported by the processor
+auto ExecuteDivuBatch(const DivisionOperands&, const DivisionResults&) -> void;
+auto ExecuteDivsBatch(const DivisionOperands&, const DivisionResults&) -> void;
+
+// Use a specific engine, falling back to Scalar when the processor doesn't support it
+auto ExecuteDivuBatch(const DivisionOperands&, const DivisionResults&, BatchIsa) -> void;
+auto ExecuteDivsBatch(const DivisionOperands&, const DivisionResults&, BatchIsa) -> void;
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <bitset>
+#include <unordered_map>
+
+#include "68000.h"
+#include "68000_Coverage.h"
+#include "68000_Distribution.h"
+#include "68000_Profile.h"
+#include "68000_Rom.h"
+
+namespace {
+
+// A goal is an edge, from * MICROWORD_COUNT + to, or a cycle count after the edges
+constexpr auto CYCLE_GOALS = MICROWORD_COUNT * MICROWORD_COUNT;
+using Goals = std::bitset<CYCLE_GOALS + CYCLE_HISTOGRAM_SIZE>;
+
+// Zero, small, around the sign bit and the largest, as both signs for DIVS.
+// The DIVU divisors above 0x8000 shift out remainder msbs, they get every quotient
+constexpr uint16_t DIVU_DIVISORS[] = { 0u, 1u, 2u, 3u, 5u, 0x7FFFu, 0x8000u, 0x8001u, 0xAAABu, 0xFFFEu, 0xFFFFu };
+constexpr uint16_t DIVU_EVERY_QUOTIENT_DIVISORS[] = { 0x8001u, 0xFFFFu };
+constexpr uint16_t DIVS_DIVISORS[] = { 0u, 1u, 2u, 3u, 5u, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFBu, 0xFFFEu, 0xFFFFu };
+
+auto Run(const CoverageVector& vector, ProfileTraceSink& sink) -> uint32_t {
+    auto mc68000 = LoadDivision(vector.dividend, vector.divisor);
+    (vector.instruction == DivisionInstruction::Divs) ? mc68000.ExecuteDivs(sink) : mc68000.ExecuteDivu(sink);
+    return mc68000.cycles;
+}
+
+// Quotients whose bits 15 to 1 the loop branches on, with each count of 1 bits and at each position
+auto QuotientPatterns() -> std::vector<uint16_t> {
+    std::vector<uint16_t> quotients{ 0x0000u, 0x5555u, 0xAAAAu, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFFu };
+    for (auto k = 0u; k < 16u; ++k) {
+        const auto ones = static_cast<uint16_t>((1u << k) - 1u);
+        quotients.insert(quotients.end(), { ones, static_cast<uint16_t>(~ones), static_cast<uint16_t>(1u << k),
+                                            static_cast<uint16_t>(ones << 1u | 1u) });
+    }
+    std::sort(quotients.begin(), quotients.end());
+    quotients.erase(std::unique(quotients.begin(), quotients.end()), quotients.end());
+    return quotients;
+}
+
+auto Remainders(uint32_t divisor, bool spread) -> std::vector<uint32_t> {
+    std::vector<uint32_t> remainders{ 0u, divisor / 2u, divisor - 1u };
+    if (spread) {
+        remainders.insert(remainders.end(), { divisor / 4u, divisor / 4u * 3u });
+    }
+    std::sort(remainders.begin(), remainders.end());
+    remainders.erase(std::unique(remainders.begin(), remainders.end()), remainders.end());
+    return remainders;
+}
+
+auto GoalsOf(const CoverageGoals& goals) -> Goals {
+    Goals set;
+    for (const auto& [from, to] : goals.edges) {
+        set.set(from * MICROWORD_COUNT + to);
+    }
+    for (const auto cycles : goals.cycles) {
+        set.set(CYCLE_GOALS + cycles);
+    }
+    return set;
+}
+
+auto GoalsToCoverage(const Goals& set) -> CoverageGoals {
+    CoverageGoals goals;
+    for (auto i = 0u; i < set.size(); ++i) {
+        if (!set.test(i)) {
+            continue;
+        }
+        if (i < CYCLE_GOALS) {
+            goals.edges.emplace_back(i / MICROWORD_COUNT, i % MICROWORD_COUNT);
+        } else {
+            goals.cycles.push_back(i - CYCLE_GOALS);
+        }
+    }
+    return goals;
+}
+
+// Greedy set cover of goals by the candidates, one candidate per distinct set of goals it reaches.
+// Leaves the goals no candidate reaches in goals
+auto Cover(DivisionInstruction instruction, Goals& goals, std::vector<CoverageVector>& vectors) -> void {
+    const auto edges = CoverageEdgesOf(instruction);
+    std::unordered_map<Goals, CoverageVector> distinct;
+    ProfileTraceSink sink;
+    for (const auto& candidate : CoverageCandidates(instruction)) {
+        const auto cycles = Run(candidate, sink);
+        Goals reached;
+        reached.set(CYCLE_GOALS + cycles);
+        // Only the edges of the ROM can be taken, they are cleared for the next candidate as they are read
+        for (const auto& [from, to] : edges) {
+            if (sink.branches[from][to] != 0u) {
+                reached.set(from * MICROWORD_COUNT + to);
+                sink.branches[from][to] = 0u;
+            }
+        }
+        distinct.try_emplace(reached & goals, candidate);
+    }
+    // Ordered by the candidates, so the result doesn't depend on the order of the map
+    std::vector<std::pair<Goals, CoverageVector>> sets(distinct.begin(), distinct.end());
+    const auto order = [](const CoverageVector& v) { return std::pair{ v.divisor, v.dividend }; };
+    std::sort(sets.begin(), sets.end(), [&](const auto& a, const auto& b) { return order(a.second) < order(b.second); });
+
+    std::vector<std::size_t> picks;
+    while (true) {
+        auto best = sets.size();
+        auto bestCount = std::size_t{};
+        for (auto i = std::size_t{}; i < sets.size(); ++i) {
+            const auto count = (sets[i].first & goals).count();
+            if (count > bestCount) {
+                best = i;
+                bestCount = count;
+            }
+        }
+        if (best == sets.size()) {
+            break;
+        }
+        goals &= ~sets[best].first;
+        picks.push_back(best);
+    }
+    // An early pick may have been made redundant by the later ones
+    for (auto i = std::size_t{}; i < picks.size();) {
+        Goals others;
+        for (auto j = std::size_t{}; j < picks.size(); ++j) {
+            others |= (j != i) ? sets[picks[j]].first : Goals{};
+        }
+        if ((sets[picks[i]].first & ~others).none()) {
+            picks.erase(picks.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+    for (const auto pick : picks) {
+        vectors.push_back(sets[pick].second);
+    }
+}
+
+}
+
+// Walks the ROM from the first microword
+auto CoverageEdgesOf(DivisionInstruction instruction) -> std::vector<MicrowordEdge> {
+    std::vector<MicrowordEdge> edges;
+    std::bitset<MICROWORD_COUNT> visited;
+    std::vector<uint16_t> pending{ static_cast<uint16_t>((instruction == DivisionInstruction::Divs) ? DVS01 : DVUR1) };
+    while (!pending.empty()) {
+        const auto microword = pending.back();
+        pending.pop_back();
+        if (visited.test(microword) || MICROCODE_ROM[microword].nanoword == Nanoword::Exit) {
+            continue;
+        }
+        visited.set(microword);
+        for (const auto next : MICROCODE_ROM[microword].next) {
+            edges.emplace_back(microword, next);
+            pending.push_back(next);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
+
+// The cycles are those of every dividend of the candidate divisors, which include the divisors reaching the
+// fewest and most cycles
+auto CoverageGoalsOf(DivisionInstruction instruction) -> CoverageGoals {
+    CoverageGoals goals{ CoverageEdgesOf(instruction), {} };
+    CycleHistogram histogram;
+    if (instruction == DivisionInstruction::Divs) {
+        for (const auto divisor : DIVS_DIVISORS) {
+            histogram += DivsCycleHistogram(divisor);
+        }
+    } else {
+        for (const auto divisor : DIVU_DIVISORS) {
+            histogram += DivuCycleHistogram(divisor);
+        }
+    }
+    for (auto cycles = 0u; cycles < CYCLE_HISTOGRAM_SIZE; ++cycles) {
+        if (histogram.counts[cycles] != 0u) {
+            goals.cycles.push_back(cycles);
+        }
+    }
+    return goals;
+}
+
+auto CoveragePathOf(const CoverageVector& vector) -> CoveragePath {
+    ProfileTraceSink sink;
+    CoveragePath path{ {}, Run(vector, sink) };
+    for (auto from = 0u; from < MICROWORD_COUNT; ++from) {
+        for (auto to = 0u; to < MICROWORD_COUNT; ++to) {
+            if (sink.branches[from][to] != 0u) {
+                path.edges.emplace_back(from, to);
+            }
+        }
+    }
+    return path;
+}
+
+auto CoverageCandidates(DivisionInstruction instruction) -> std::vector<CoverageVector> {
+    std::vector<CoverageVector> candidates;
+    const auto add = [&](uint32_t dividend, uint16_t divisor) { candidates.push_back({ instruction, dividend, divisor }); };
+    const auto quotients = QuotientPatterns();
+    if (instruction == DivisionInstruction::Divu) {
+        for (const auto divisor : DIVU_DIVISORS) {
+            // Overflow, or the dividends of the zero divisor
+            add(static_cast<uint32_t>(divisor) << 16u, divisor);
+            add(0xFFFF'FFFFu, divisor);
+            if (divisor == 0u) {
+                continue;
+            }
+            const auto everyQuotient = std::ranges::find(DIVU_EVERY_QUOTIENT_DIVISORS, divisor) !=
+                                       std::end(DIVU_EVERY_QUOTIENT_DIVISORS);
+            const auto remainders = Remainders(divisor, everyQuotient);
+            const auto addQuotient = [&](uint32_t quotient) {
+                for (const auto remainder : remainders) {
+                    add(quotient * divisor + remainder, divisor);
+                }
+            };
+            if (everyQuotient) {
+                for (auto quotient = 0u; quotient <= 0xFFFFu; ++quotient) {
+                    addQuotient(quotient);
+                }
+            } else {
+                std::ranges::for_each(quotients, addQuotient);
+            }
+        }
+        return candidates;
+    }
+    for (const auto divisor : DIVS_DIVISORS) {
+        // The largest dividends of both signs overflow early for every divisor
+        add(0x7FFF'FFFFu, divisor);
+        add(0x8000'0000u, divisor);
+        if (divisor == 0u) {
+            add(0u, divisor);
+            continue;
+        }
+        const auto absDivisor = (divisor & 0x8000u) ? 0x1'0000u - divisor : uint32_t{ divisor };
+        const auto addAbsolute = [&](uint64_t absDividend) {
+            if (absDividend <= 0x7FFF'FFFFu) {
+                add(static_cast<uint32_t>(absDividend), divisor);
+            }
+            if (absDividend != 0u && absDividend <= 0x8000'0000u) {
+                add(static_cast<uint32_t>(0u - absDividend), divisor);
+            }
+        };
+        addAbsolute(uint64_t{ absDivisor } << 16u);
+        for (const auto quotient : quotients) {
+            for (const auto remainder : Remainders(absDivisor, false)) {
+                addAbsolute(uint64_t{ quotient } * absDivisor + remainder);
+            }
+        }
+    }
+    return candidates;
+}
+
+auto MinimalCoverage() -> CoverageResult {
+    CoverageResult result;
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        auto goals = GoalsOf(CoverageGoalsOf(instruction));
+        Cover(instruction, goals, result.vectors);
+        result.uncovered[static_cast<int>(instruction)] = GoalsToCoverage(goals);
+    }
+    return result;
+}
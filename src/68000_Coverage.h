@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "68000_Batch.h"
+
+// A small set of divisions that takes every branch of the DIVU and DIVS microcode and every cycle count.
+//
+// The goals of an instruction are the edges between microwords of the ROM (68000_Rom.h) reachable from its
+// first microword, including those into the DIVU microwords DIVS shares and into TRAP0 and A1, and the cycle
+// counts of every dividend of the candidate divisors (68000_Distribution.h), which between them reach the
+// fewest and most cycles of any divisor. The candidates are built from the structure of the microcode rather
+// than searched for: zero divisors, early overflows, and for each divisor of a fixed set the quotient patterns
+// the loop branches on (every count of 1 bits, single bits, the signed limits) with remainders across the
+// range, both signs for DIVS. Every candidate is run through the microcode with a ProfileTraceSink, and a
+// greedy set cover picks the candidate covering most of the remaining goals until none is left, then drops
+// any pick whose goals the others cover too. Each division has one cycle count, so the number of cycle counts
+// is a lower bound on the size of the set; the current microcode meets it.
+
+using MicrowordEdge = std::pair<uint16_t, uint16_t>; // From, to
+
+struct CoverageVector {
+    DivisionInstruction instruction;
+    uint32_t dividend;
+    uint16_t divisor;
+};
+
+// The edges a division takes and its cycles
+struct CoveragePath {
+    std::vector<MicrowordEdge> edges; // Sorted, each once
+    uint32_t cycles;
+};
+
+struct CoverageGoals {
+    std::vector<MicrowordEdge> edges; // Sorted
+    std::vector<uint32_t> cycles; // Sorted
+};
+
+struct CoverageResult {
+    std::vector<CoverageVector> vectors; // DIVU first, then DIVS, in the order picked
+    CoverageGoals uncovered[2]; // Goals no candidate reaches, by DivisionInstruction
+};
+
+auto CoverageEdgesOf(DivisionInstruction) -> std::vector<MicrowordEdge>; // Sorted
+auto CoverageGoalsOf(DivisionInstruction) -> CoverageGoals;
+auto CoveragePathOf(const CoverageVector&) -> CoveragePath;
+auto CoverageCandidates(DivisionInstruction) -> std::vector<CoverageVector>;
+auto MinimalCoverage() -> CoverageResult;
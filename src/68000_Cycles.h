@@ -0,0 +1,103 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+// Closed-form cycle counts for the division and multiplication microcode.
+// These return exactly what the MC68000 execute functions accumulate in cycles
+// without running the main loop. They take constant time, a popcount of the quotient, except for DIVU with a
+// divisor above 0x8000, which adds the fixed 15 step DivuShiftedOutBits.
+
+// Number of the DIVU quotient bits 15 to 1 produced after the msb of the remainder was shifted out.
+// The remainder before quotient bit j is produced is ((quotient mod 2^(j + 1)) * divisor + remainder) >> (j + 1),
+// which can only reach 0x8000 when the divisor exceeds it.
+// This depends on the divisor, the quotient and the remainder together, one compare per bit. A table of the
+// remainder thresholds would need an entry for each of the 2^31 divisors above 0x8000 and quotients, so it stays
+// a loop.
+constexpr auto DivuShiftedOutBits(uint32_t quotient, uint32_t remainder, uint16_t divisor) -> uint32_t {
+    auto shifted = 0u;
+    if (divisor > 0x8000u) {
+        for (auto j = 1u; j < 16u; ++j) {
+            const auto low = quotient & ((2u << j) - 1u);
+            shifted += ((low * divisor + remainder) >> (j + 1u)) >> 15u;
+        }
+    }
+    return shifted;
+}
+
+// Cycles for DIVU
+// Every microword takes 2 cycles. Outside the main loop the path is fixed
+//     DVUR1, DVUM2, DVUM3, 16 x (DVUM5/6, DVUM7/8), DVUM9/C, DVUMD/F, DVUM0
+// The first 15 iterations each produce a quotient bit (15 down to 1) and cost extra depending on that bit
+//     0 bit: DVUMB, DVUME
+//     1 bit: DVUMB
+//     1 bit when the msb of the remainder was shifted out: nothing, DVUM7 goes straight to DVUM6
+constexpr auto DivuCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    if (divisor == 0u) {
+        return 2u * 2u; // DVUR1, DVUM2
+    }
+    if ((dividend >> 16u) >= divisor) {
+        return 5u * 2u; // DVUR1, DVUM2, DVUM3, DVUM4, DVUMA
+    }
+
+    const auto quotient = dividend / divisor;
+    const auto remainder = dividend % divisor;
+    const auto ones = static_cast<uint32_t>(std::popcount(quotient >> 1u));
+    const auto shifted = DivuShiftedOutBits(quotient, remainder, divisor);
+
+    return 38u * 2u + 4u * (15u - ones) + 2u * (ones - shifted);
+}
+
+// Cycles for DIVS
+// The main loop works with absolute values and has no shortcut for the msb,
+// so the timing depends on the signs of the operands and the number of 0 bits in the absolute quotient
+//     DVS01, DVS03, DVS04/5, DVS06, (DVS07 | DVS10, DVS11), DVS08
+//     16 x (DVS09/A, DVS0C), 15 x DVS0D, DVS0F for each 0 bit, DVS0E, DVS12/13, DVS14
+// followed by the sign correction, which has the same length for the overflow exit
+//     negative divisor: DVS15, DVS1D, DVS1E/F, DVS1C/DVUM4/DVS20, LEAA2/DVUMA
+//     positive divisor, negative dividend: DVS15, DVS16, DVS1A, DVS1B, DVS1C/DVUM4, LEAA2/DVUMA
+//     positive divisor, positive dividend: DVS15, DVS16, DVS17, LEAA2/DVUMA
+constexpr auto DivsCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    if (divisor == 0u) {
+        return 2u * 2u; // DVS01, DVS03
+    }
+
+    const auto negativeDividend = (dividend & 0x8000'0000u) != 0u;
+    const auto negativeDivisor = (divisor & 0x8000u) != 0u;
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - divisor : divisor);
+
+    auto cycles = negativeDividend ? 7u * 2u : 6u * 2u;
+
+    if ((absDividend >> 16u) >= absDivisor) {
+        return cycles + 2u * 2u; // DVUMZ, DVUMA
+    }
+
+    const auto ones = static_cast<uint32_t>(std::popcount((absDividend / absDivisor) >> 1u));
+    cycles += 50u * 2u + (15u - ones) * 2u;
+
+    if (negativeDivisor) {
+        cycles += 5u * 2u;
+    } else if (negativeDividend) {
+        cycles += 6u * 2u;
+    } else {
+        cycles += 4u * 2u;
+    }
+    return cycles;
+}
+
+// Cycles for MULU
+// Every microword takes 2 cycles
+//     MULR1, MULM2, 16 x MULM4, MULM6
+// and one MULM3 for each 1 bit of the multiplier
+constexpr auto MuluCycles(uint16_t multiplier) -> uint32_t {
+    return 19u * 2u + 2u * static_cast<uint32_t>(std::popcount(multiplier));
+}
+
+// Cycles for MULS
+// The same path as MULU but the add (MULM3) or subtract (MULM5) happens for every bit
+// that differs from the one below it, with a 0 below bit 0
+constexpr auto MulsCycles(uint16_t multiplier) -> uint32_t {
+    const auto changes = (multiplier ^ (static_cast<uint32_t>(multiplier) << 1u)) & 0xFFFFu;
+    return 19u * 2u + 2u * static_cast<uint32_t>(std::popcount(changes));
+}
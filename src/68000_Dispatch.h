@@ -0,0 +1,34 @@
+#pragma once
+
+// Microword dispatch for the execute functions.
+//
+// By default the execute functions loop around a switch on the microword.
+// With M68K_THREADED_DISPATCH (GCC and Clang only) every microword ends with its own indirect jump
+// through a table of label addresses indexed by the microword, so the branch predictor sees one
+// jump per microword rather than the single jump shared by the whole switch.
+//
+// The microword bodies are written once against these macros
+//     MICROWORD(label): { ... microword = next; DISPATCH(); }
+// Every dispatch reports the step to the trace sink, so the execute functions declare
+// the sink and the previous microword as sink and previous.
+//
+// Execute functions that can stop part way through an instruction also declare Budgeted and deadline.
+// With Budgeted they stop before any microword but the exits once cycles reaches deadline (M68K_PAUSED),
+// leaving microword to be resumed from; the loop checks at its top, threaded dispatch jumps to microword_pause.
+
+#if M68K_THREADED_DISPATCH && (defined(__GNUC__) || defined(__clang__))
+#define M68K_USE_THREADED_DISPATCH 1
+#endif
+
+#define M68K_PAUSED() (Budgeted && cycles >= deadline && microword != A1 && microword != TRAP0)
+
+#if M68K_USE_THREADED_DISPATCH
+#define MICROWORD(label) microword_##label
+#define DISPATCH() do { \
+        if (M68K_PAUSED()) { goto microword_pause; } \
+        cycles += 2u; Step(sink, previous, *this); goto *dispatch[microword]; \
+    } while (false)
+#else
+#define MICROWORD(label) case label
+#define DISPATCH() break
+#endif
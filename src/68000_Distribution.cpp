@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <bit>
+
+#include "68000_Cycles.h"
+#include "68000_Distribution.h"
+
+namespace {
+
+constexpr auto QUOTIENT_BITS = 15u; // Quotient bits 15 to 1 set the timing, bit 0 doesn't
+
+// Number of quotient patterns with each count of 1 bits, by adding the bits one at a time
+constexpr auto QUOTIENT_ONES = [] {
+    std::array<uint64_t, QUOTIENT_BITS + 1u> ones{ 1u };
+    for (auto bit = 0u; bit < QUOTIENT_BITS; ++bit) {
+        for (auto k = bit + 1u; k > 0u; --k) {
+            ones[k] += ones[k - 1u];
+        }
+    }
+    return ones;
+}();
+
+// A quotient with ones 1 bits among bits 15 to 1, and bit 0 set so it is never 0
+constexpr auto QuotientWithOnes(uint32_t ones) -> uint32_t {
+    return ((1u << ones) - 1u) << 1u | 1u;
+}
+
+}
+
+auto CycleHistogram::Total() const -> uint64_t {
+    auto total = uint64_t{};
+    for (const auto count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+auto CycleHistogram::Min() const -> uint32_t {
+    for (auto i = 0u; i < CYCLE_HISTOGRAM_SIZE; ++i) {
+        if (counts[i] != 0u) {
+            return i;
+        }
+    }
+    return 0u;
+}
+
+auto CycleHistogram::Max() const -> uint32_t {
+    for (auto i = CYCLE_HISTOGRAM_SIZE; i > 0u; --i) {
+        if (counts[i - 1u] != 0u) {
+            return i - 1u;
+        }
+    }
+    return 0u;
+}
+
+auto CycleHistogram::Mean() const -> double {
+    auto sum = 0.0;
+    auto total = uint64_t{};
+    for (auto i = 0u; i < CYCLE_HISTOGRAM_SIZE; ++i) {
+        sum += static_cast<double>(i) * static_cast<double>(counts[i]);
+        total += counts[i];
+    }
+    return (total != 0u) ? sum / static_cast<double>(total) : 0.0;
+}
+
+auto AddDivuQuotientCycles(CycleHistogram& histogram, uint16_t divisor, uint16_t quotient) -> void {
+    const auto lowest = static_cast<uint32_t>(quotient) * divisor;
+    if (divisor <= 0x8000u) {
+        histogram.Add(DivuCycles(lowest, divisor), divisor);
+        return;
+    }
+    // Quotient bit j comes from a shifted out msb for the remainders from thresholds[j - 1] up,
+    // see DivuShiftedOutBits
+    std::array<uint32_t, QUOTIENT_BITS> thresholds{};
+    auto shiftedAtZero = 0u;
+    for (auto j = 1u; j <= QUOTIENT_BITS; ++j) {
+        const auto low = static_cast<int64_t>(quotient & ((2u << j) - 1u)) * divisor;
+        const auto threshold = std::clamp((int64_t{ 0x8000 } << (j + 1u)) - low, int64_t{ 0 }, int64_t{ divisor });
+        thresholds[j - 1u] = static_cast<uint32_t>(threshold);
+        shiftedAtZero += (threshold == 0) ? 1u : 0u;
+    }
+    std::sort(thresholds.begin(), thresholds.end());
+
+    // Each remainder run between two thresholds has one more shifted out bit than the run before
+    const auto cycles = DivuCycles(lowest, divisor) + 2u * shiftedAtZero;
+    auto start = 0u;
+    for (auto i = 0u; i <= QUOTIENT_BITS; ++i) {
+        const auto end = (i < QUOTIENT_BITS) ? thresholds[i] : static_cast<uint32_t>(divisor);
+        if (end > start) {
+            histogram.Add(cycles - 2u * i, end - start);
+            start = end;
+        }
+    }
+}
+
+auto DivuCycleHistogram(uint16_t divisor) -> CycleHistogram {
+    CycleHistogram histogram;
+    if (divisor == 0u) {
+        histogram.Add(DivuCycles(0u, 0u), uint64_t{ 1 } << 32u);
+        return histogram;
+    }
+    const auto overflows = (uint64_t{ 1 } << 32u) - (uint64_t{ divisor } << 16u);
+    if (overflows != 0u) {
+        histogram.Add(DivuCycles(static_cast<uint32_t>(divisor) << 16u, divisor), overflows);
+    }
+    if (divisor <= 0x8000u) {
+        for (auto ones = 0u; ones <= QUOTIENT_BITS; ++ones) {
+            const auto quotient = QuotientWithOnes(ones);
+            histogram.Add(DivuCycles(quotient * divisor, divisor), 2u * QUOTIENT_ONES[ones] * divisor);
+        }
+        return histogram;
+    }
+    for (auto quotient = 0u; quotient <= 0xFFFFu; ++quotient) {
+        AddDivuQuotientCycles(histogram, divisor, static_cast<uint16_t>(quotient));
+    }
+    return histogram;
+}
+
+// Absolute dividends 0 to 2^31 - 1 for positive dividends and 1 to 2^31 for negative ones,
+// those below absDivisor << 16 don't overflow
+auto DivsCycleHistogram(uint16_t divisor) -> CycleHistogram {
+    CycleHistogram histogram;
+    if (divisor == 0u) {
+        histogram.Add(DivsCycles(0u, 0u), uint64_t{ 1 } << 32u);
+        return histogram;
+    }
+    const auto absDivisor = static_cast<uint16_t>((divisor & 0x8000u) ? 0u - divisor : divisor);
+    const auto divisions = uint64_t{ absDivisor } << 16u; // Absolute dividends that don't overflow
+    if (divisions != (uint64_t{ 1 } << 31u)) {
+        histogram.Add(DivsCycles(0x7FFF'FFFFu, divisor), (uint64_t{ 1 } << 31u) - divisions);
+    }
+    histogram.Add(DivsCycles(0x8000'0000u, divisor), (uint64_t{ 1 } << 31u) - divisions + 1u);
+    for (auto ones = 0u; ones <= QUOTIENT_BITS; ++ones) {
+        const auto dividend = QuotientWithOnes(ones) * absDivisor;
+        const auto count = 2u * QUOTIENT_ONES[ones] * absDivisor;
+        histogram.Add(DivsCycles(dividend, divisor), count);
+        histogram.Add(DivsCycles(0u - dividend, divisor), (ones == 0u) ? count - 1u : count); // Not 0
+    }
+    return histogram;
+}
+
+auto CycleHistogramOf(DivisionInstruction instruction, uint16_t divisor) -> CycleHistogram {
+    return (instruction == DivisionInstruction::Divs) ? DivsCycleHistogram(divisor) : DivuCycleHistogram(divisor);
+}
+
+// Every class of dividends is counted at a representative dividend: an even quotient (0 or 2) and an odd one (1)
+// for each sign, and the overflows as in DivuCycleHistogram and DivsCycleHistogram
+auto CycleHistogramOf(DividerModel model, DivisionInstruction instruction, uint16_t divisor) -> CycleHistogram {
+    if (model == DividerModel::Restoring) {
+        return CycleHistogramOf(instruction, divisor);
+    }
+    CycleHistogram histogram;
+    const auto cycles = [&](uint32_t dividend) { return DividerCycles(model, instruction, dividend, divisor); };
+    if (divisor == 0u) {
+        histogram.Add(cycles(0u), uint64_t{ 1 } << 32u);
+        return histogram;
+    }
+    if (instruction == DivisionInstruction::Divu) {
+        const auto divisions = uint64_t{ divisor } << 16u;
+        if (divisions != (uint64_t{ 1 } << 32u)) {
+            histogram.Add(cycles(static_cast<uint32_t>(divisor) << 16u), (uint64_t{ 1 } << 32u) - divisions);
+        }
+        histogram.Add(cycles(0u), divisions / 2u);
+        histogram.Add(cycles(divisor), divisions / 2u);
+        return histogram;
+    }
+    const auto absDivisor = static_cast<uint16_t>((divisor & 0x8000u) ? 0u - divisor : divisor);
+    const auto divisions = uint64_t{ absDivisor } << 16u;
+    if (divisions != (uint64_t{ 1 } << 31u)) {
+        histogram.Add(cycles(0x7FFF'FFFFu), (uint64_t{ 1 } << 31u) - divisions);
+    }
+    histogram.Add(cycles(0x8000'0000u), (uint64_t{ 1 } << 31u) - divisions + 1u);
+    histogram.Add(cycles(0u), divisions / 2u);
+    histogram.Add(cycles(absDivisor), divisions / 2u);
+    histogram.Add(cycles(0u - 2u * absDivisor), divisions / 2u - 1u); // Not 0
+    histogram.Add(cycles(0u - absDivisor), divisions / 2u);
+    return histogram;
+}
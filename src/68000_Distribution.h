@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "68000_Batch.h"
+#include "68000_Dividers.h"
+
+// Exact cycle count distributions of DIVU and DIVS over all 2^32 dividends of a divisor, without running them.
+//
+// Outside the overflow and zero exits the cycles only depend on the signs and the quotient bits 15 to 1
+// (see 68000_Cycles.h), so every quotient stands for a whole run of dividends, one per remainder.
+// Grouping the 2^15 quotient patterns by their number of 1 bits, counted by dynamic programming over the bits,
+// leaves 16 classes per sign. DIVU divisors above 0x8000 also skip DVUMB for quotient bits produced from a
+// shifted out remainder msb. Whether that happens for bit j is a threshold on the remainder, so each quotient
+// splits its remainders into at most 16 runs instead of being counted one by one.
+
+constexpr auto CYCLE_HISTOGRAM_SIZE = 256u; // Longer than any division
+
+struct CycleHistogram {
+    std::array<uint64_t, CYCLE_HISTOGRAM_SIZE> counts{}; // Indexed by cycles
+
+    auto Add(uint32_t cycles, uint64_t count) -> void { counts[cycles] += count; }
+
+    auto operator+=(const CycleHistogram& other) -> CycleHistogram& {
+        for (auto i = 0u; i < CYCLE_HISTOGRAM_SIZE; ++i) {
+            counts[i] += other.counts[i];
+        }
+        return *this;
+    }
+
+    auto Total() const -> uint64_t;
+    auto Min() const -> uint32_t; // 0 when empty
+    auto Max() const -> uint32_t;
+    auto Mean() const -> double;
+};
+
+auto DivuCycleHistogram(uint16_t divisor) -> CycleHistogram;
+auto DivsCycleHistogram(uint16_t divisor) -> CycleHistogram;
+auto CycleHistogramOf(DivisionInstruction, uint16_t divisor) -> CycleHistogram;
+
+// The same for the what-if models of 68000_Dividers.h, whose main loops only depend on quotient bit 0 at most
+auto CycleHistogramOf(DividerModel, DivisionInstruction, uint16_t divisor) -> CycleHistogram;
+
+// Adds the DIVU cycles of every dividend quotient * divisor + remainder, remainder < divisor
+auto AddDivuQuotientCycles(CycleHistogram&, uint16_t divisor, uint16_t quotient) -> void;
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <bit>
+
+#include "68000_Cycles.h"
+#include "68000_Dividers.h"
+
+namespace {
+
+constexpr auto SRT4_DIGITS = 9u; // The first digit covers the top 2 bits of the 18 bit quotient, which are 0
+
+// Main loop of the non-restoring model on a division that doesn't overflow, with the dividend in alu:alue, N set
+// from alu and the divisor in alub. Leaves the remainder in alu and quotient bits 15 to 1 in alue, returns bit 0.
+// As in DVUM5 to DVUMB, au counts the iterations and alu:alue shifts the dividend out at the top of alue and the
+// quotient bits in at the bottom, each one iteration late. The partial remainder takes 17 bits, alu and its sign.
+// Like the shifted out msb of DVUM7 and DVUM8, the sign picks the next microword rather than being kept in a register.
+// Every quotient bit is the one the restoring division produces, only the remainder needs the correction
+auto NonRestoringLoop(MC68000& mc68000) -> uint16_t {
+    mc68000.ath = 0u - mc68000.alub; // Adding the divisor is subtracting its negation
+    auto negative = false;
+    auto bit = uint16_t{};
+    for (mc68000.au = 16u; mc68000.au != 0u;) {
+        mc68000.cycles += 2u; // Shift the partial remainder and the dividend left
+        mc68000.au = mc68000.au - 1u;
+        const auto msb = (mc68000.AluOp_SLAAx(bit) & FLAG_N) != 0u;
+        mc68000.cycles += 2u; // Add the divisor to a negative partial remainder, subtract it from the others
+        mc68000.AluOp_SUB(mc68000.alu, negative ? mc68000.ath : mc68000.alub);
+        const auto borrow = (mc68000.Flags() & FLAG_C) != 0u;
+        negative = msb != (negative ? !borrow : borrow); // Bit 16 of the result
+        bit = negative ? 0u : 1u;
+    }
+    if (negative) {
+        mc68000.cycles += 2u; // Correct the remainder
+        mc68000.AluOp_SUB(mc68000.alu, mc68000.ath);
+    }
+    return bit;
+}
+
+// Main loop of the radix 4 SRT model, with the same registers in and out as NonRestoringLoop.
+// The digits are selected by rounding the partial remainder to the nearest multiple of the divisor, limited
+// to -2 to 2. The partial remainder stays within 2/3 of the normalized divisor, which leaves a margin of
+// 1/6 of it for the few bits of the remainder and divisor a selection table would look at.
+// The 68000 ALU has no 2 bit shift, 19 bit adder or selection table, so the loop works on integers
+auto Srt4Loop(MC68000& mc68000) -> uint16_t {
+    const auto dividend = static_cast<uint32_t>(mc68000.alu) << 16u | mc68000.alue;
+    mc68000.cycles += 2u; // Normalize the divisor
+    const auto shift = static_cast<uint32_t>(std::countl_zero(mc68000.alub));
+    const auto normalized = static_cast<uint64_t>(dividend) << shift;
+    const auto divisorValue = static_cast<int64_t>(mc68000.alub) << shift;
+    auto remainder = static_cast<int64_t>(normalized >> (2u * SRT4_DIGITS));
+    auto quotient = int32_t{};
+    for (auto digit = 0u; digit < SRT4_DIGITS; ++digit) {
+        mc68000.cycles += 2u; // Shift in 2 dividend bits, select the digit and add its multiple of the divisor
+        const auto partial = 4 * remainder + static_cast<int64_t>((normalized >> (2u * (SRT4_DIGITS - 1u - digit))) & 3u);
+        const auto twice = 2 * partial + divisorValue;
+        const auto rounded = (twice >= 0) ? twice / (2 * divisorValue) : -((2 * divisorValue - 1 - twice) / (2 * divisorValue));
+        const auto selected = std::clamp<int64_t>(rounded, -2, 2);
+        remainder = partial - selected * divisorValue;
+        quotient = 4 * quotient + static_cast<int32_t>(selected);
+    }
+    mc68000.cycles += 2u; // Select the corrected quotient and remainder when the remainder is negative
+    if (remainder < 0) {
+        remainder += divisorValue;
+        quotient -= 1;
+    }
+    mc68000.cycles += 2u; // Denormalize the remainder
+    mc68000.alu = static_cast<uint16_t>(remainder >> shift);
+    mc68000.alue = static_cast<uint16_t>(quotient >> 1);
+    return static_cast<uint16_t>(quotient & 1);
+}
+
+// Loads the dividend into alu:alue and the divisor into alub as DVUR1 and DVUM3 do, then runs the main loop
+auto ModelLoop(DividerModel model, MC68000& mc68000, uint32_t dividend, uint16_t divisor) -> uint16_t {
+    mc68000.alue = static_cast<uint16_t>(dividend);
+    mc68000.alub = divisor;
+    mc68000.AluOp_AND(static_cast<uint16_t>(dividend >> 16u), 0xFFFFu);
+    return (model == DividerModel::Srt4) ? Srt4Loop(mc68000) : NonRestoringLoop(mc68000);
+}
+
+// Takes the remainder out of alu and shifts quotient bit 0 into alue as DVUM9/C and DVUMD/F do
+auto WriteBack(MC68000& mc68000, uint16_t bit) -> uint16_t {
+    const auto remainder = mc68000.alu;
+    mc68000.AluOp_AND(mc68000.alu, 0u);
+    mc68000.AluOp_SLAAx(bit);
+    return remainder;
+}
+
+auto ModelLoopCycles(DividerModel model, uint32_t quotient) -> uint32_t {
+    if (model == DividerModel::Srt4) {
+        return 2u * (1u + SRT4_DIGITS + 2u);
+    }
+    return 2u * (32u + ((quotient & 1u) ? 0u : 1u));
+}
+
+// The microwords of the restoring main loop, see DivuCycles and DivsCycles
+auto RestoringLoopCycles(DivisionInstruction instruction, uint32_t quotient, uint16_t divisor, uint32_t remainder) -> uint32_t {
+    const auto ones = static_cast<uint32_t>(std::popcount(quotient >> 1u));
+    if (instruction == DivisionInstruction::Divs) {
+        return 2u * (47u + 15u - ones); // 16 x (DVS09/A, DVS0C), 15 x DVS0D, DVS0F
+    }
+    // 16 x (DVUM5/6, DVUM7/8), DVUMB and DVUME
+    return 2u * (32u + 2u * (15u - ones) + ones - DivuShiftedOutBits(quotient, remainder, divisor));
+}
+
+auto ExecuteDivu(DividerModel model, MC68000& mc68000) -> void {
+    const auto dividend = static_cast<uint32_t>(mc68000.rxdh) << 16u | mc68000.rxdl;
+    if (mc68000.rydl == 0u || mc68000.rxdh >= mc68000.rydl) {
+        mc68000.ExecuteDivu(); // The zero and overflow exits come before the main loop
+        return;
+    }
+    mc68000.cycles += 3u * 2u; // DVUR1, DVUM2, DVUM3
+    const auto bit = ModelLoop(model, mc68000, dividend, mc68000.rydl);
+    mc68000.cycles += 3u * 2u; // DVUM9/C, DVUMD/F, DVUM0
+    mc68000.rxdh = WriteBack(mc68000, bit);
+    mc68000.rxdl = mc68000.alue;
+    mc68000.AluOp_AND(mc68000.alue, 0xFFFFu);
+    mc68000.SyncFlags();
+    mc68000.flags &= FLAG_N | FLAG_Z;
+    mc68000.microword = A1;
+}
+
+auto ExecuteDivs(DividerModel model, MC68000& mc68000) -> void {
+    const auto dividend = static_cast<uint32_t>(mc68000.rxdh) << 16u | mc68000.rxdl;
+    const auto negativeDividend = (mc68000.rxdh & 0x8000u) != 0u;
+    const auto negativeDivisor = (mc68000.rydl & 0x8000u) != 0u;
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - mc68000.rydl : mc68000.rydl);
+    if (mc68000.rydl == 0u || (absDividend >> 16u) >= absDivisor) {
+        mc68000.ExecuteDivs(); // The zero and early overflow exits come before the main loop
+        return;
+    }
+    mc68000.cycles += negativeDividend ? 7u * 2u : 6u * 2u; // DVS01 to DVS08
+    const auto bit = ModelLoop(model, mc68000, absDividend, absDivisor);
+    mc68000.cycles += 3u * 2u; // DVS0E, DVS12/13, DVS14
+    const auto remainder = WriteBack(mc68000, bit);
+    // The sign correction, DVS15 to LEAA2/DVUMA
+    mc68000.cycles += negativeDivisor ? 5u * 2u : negativeDividend ? 6u * 2u : 4u * 2u;
+
+    const auto absQuotient = mc68000.alue;
+    const auto quotient = static_cast<uint16_t>((negativeDivisor != negativeDividend) ? 0u - absQuotient : absQuotient);
+    const auto lateOverflow = (negativeDivisor != negativeDividend) ? absQuotient > 0x8000u : absQuotient > 0x7FFFu;
+    mc68000.microword = A1;
+    if (lateOverflow) {
+        mc68000.SyncFlags();
+        mc68000.flags = FLAG_V;
+        return;
+    }
+    mc68000.rxdh = static_cast<uint16_t>(negativeDividend ? 0u - remainder : remainder);
+    mc68000.rxdl = quotient;
+    mc68000.AluOp_AND(quotient, 0xFFFFu);
+    mc68000.SyncFlags();
+    mc68000.flags &= FLAG_N | FLAG_Z;
+}
+
+}
+
+auto DividerModelName(DividerModel model) -> const char* {
+    switch (model) {
+        case DividerModel::Restoring:
+            return "restoring";
+        case DividerModel::NonRestoring:
+            return "nonrestoring";
+        case DividerModel::Srt4:
+            return "srt4";
+    }
+    return "?";
+}
+
+auto ExecuteDivision(DividerModel model, DivisionInstruction instruction, MC68000& mc68000) -> void {
+    if (model == DividerModel::Restoring) {
+        (instruction == DivisionInstruction::Divs) ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+        return;
+    }
+    (instruction == DivisionInstruction::Divs) ? ExecuteDivs(model, mc68000) : ExecuteDivu(model, mc68000);
+}
+
+auto DividerCycles(DividerModel model, DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) -> uint32_t {
+    const auto restoring = (instruction == DivisionInstruction::Divs) ? DivsCycles(dividend, divisor) : DivuCycles(dividend, divisor);
+    if (model == DividerModel::Restoring || divisor == 0u) {
+        return restoring;
+    }
+    const auto negativeDividend = instruction == DivisionInstruction::Divs && (dividend & 0x8000'0000u) != 0u;
+    const auto negativeDivisor = instruction == DivisionInstruction::Divs && (divisor & 0x8000u) != 0u;
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - divisor : divisor);
+    if ((absDividend >> 16u) >= absDivisor) {
+        return restoring;
+    }
+    const auto quotient = absDividend / absDivisor;
+    return restoring - RestoringLoopCycles(instruction, quotient, absDivisor, absDividend % absDivisor) +
+           ModelLoopCycles(model, quotient);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include "68000.h"
+#include "68000_Batch.h"
+
+// What-if models of other divider microarchitectures in place of the restoring division of the 68000.
+//
+// Each model keeps the parts of the real microcode around the main loop, so the zero divisor and early
+// overflow exits and the setup, sign handling and result write-back take as long as they do on the 68000.
+// Only the main loop is replaced, every modelled microword again taking 2 cycles:
+//
+//     Restoring     the 68000 microcode itself
+//     NonRestoring  16 x (shift, add or subtract by the sign of the partial remainder), never restoring,
+//                   and one correcting add at the end when the remainder is negative (quotient bit 0 is 0)
+//     Srt4          radix 4 SRT with the digits -2 to 2: normalize the divisor, 9 x (shift by 2 and select,
+//                   add or subtract 0, 1 or 2 divisors), a correcting select and denormalize the remainder.
+//                   The digits are converted to the quotient on the fly, so the correction is one microword
+//                   whatever the sign, and the loop takes 12 microwords for every operand
+//
+// NonRestoring runs on the 68000 registers and ALU operations, with the 17th bit of the partial remainder, its sign,
+// picking the next microword. Srt4 needs 19 bits, a 2 bit shift and a digit selection the ALU doesn't have, so it
+// works on integers and only takes its operands from and leaves its results in the registers.
+// The quotient, remainder, N and Z match the 68000. DIVU flags match it exactly; DIVS X and the
+// flags of the late overflow exit (a quotient that doesn't fit 16 signed bits) aren't modelled.
+
+enum class DividerModel {
+    Restoring,
+    NonRestoring,
+    Srt4,
+};
+
+constexpr DividerModel DIVIDER_MODELS[] = { DividerModel::Restoring, DividerModel::NonRestoring, DividerModel::Srt4 };
+
+auto DividerModelName(DividerModel) -> const char*; // restoring, nonrestoring, srt4
+
+// Runs DIVU or DIVS on the registers of mc68000 as ExecuteDivu and ExecuteDivs do, with the model's main loop
+auto ExecuteDivision(DividerModel, DivisionInstruction, MC68000&) -> void;
+
+// Closed-form cycles of ExecuteDivision, counted from zero
+auto DividerCycles(DividerModel, DivisionInstruction, uint32_t dividend, uint16_t divisor) -> uint32_t;
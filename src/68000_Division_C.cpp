@@ -0,0 +1,78 @@
+#include <span>
+
+#include "68000.h"
+#include "68000_Batch.h"
+#include "68000_Division_C.h"
+#include "68000_Timing.h"
+
+namespace {
+
+static_assert(sizeof(m68k_division_result) == 12u);
+
+template<bool Signed>
+auto Divide(uint32_t dividend, uint16_t divisor, m68k_division_result* result) -> int {
+    if (result == nullptr) {
+        return M68K_INVALID_ARGUMENT;
+    }
+    auto mc68000 = LoadDivision(dividend, divisor);
+    if constexpr (Signed) {
+        mc68000.ExecuteDivs();
+    } else {
+        mc68000.ExecuteDivu();
+    }
+    *result = { mc68000.rxdh, mc68000.rxdl, mc68000.flags, 0u, mc68000.cycles };
+    return M68K_OK;
+}
+
+template<bool Signed>
+auto DivideBatch(const uint32_t* dividends, const uint16_t* divisors, size_t count,
+                 uint16_t* remainders, uint16_t* quotients, uint16_t* flags, uint32_t* cycles) -> int {
+    if (count == 0u) {
+        return M68K_OK;
+    }
+    if (dividends == nullptr || divisors == nullptr || remainders == nullptr || quotients == nullptr ||
+        flags == nullptr || cycles == nullptr) {
+        return M68K_INVALID_ARGUMENT;
+    }
+    // Every span holds count elements, so the batch functions never throw across the interface
+    const DivisionOperands operands{ { dividends, count }, { divisors, count } };
+    const DivisionResults results{ { remainders, count }, { quotients, count }, { flags, count }, { cycles, count } };
+    if constexpr (Signed) {
+        ExecuteDivsBatch(operands, results);
+    } else {
+        ExecuteDivuBatch(operands, results);
+    }
+    return M68K_OK;
+}
+
+}
+
+extern "C" {
+
+auto m68k_abi_version() -> uint32_t {
+    return M68K_DIVISION_ABI_VERSION;
+}
+
+auto m68k_divu(uint32_t dividend, uint16_t divisor, m68k_division_result* result) -> int {
+    return Divide<false>(dividend, divisor, result);
+}
+
+auto m68k_divs(uint32_t dividend, uint16_t divisor, m68k_division_result* result) -> int {
+    return Divide<true>(dividend, divisor, result);
+}
+
+auto m68k_divu_batch(const uint32_t* dividends, const uint16_t* divisors, size_t count,
+                     uint16_t* remainders, uint16_t* quotients, uint16_t* flags, uint32_t* cycles) -> int {
+    return DivideBatch<false>(dividends, divisors, count, remainders, quotients, flags, cycles);
+}
+
+auto m68k_divs_batch(const uint32_t* dividends, const uint16_t* divisors, size_t count,
+                     uint16_t* remainders, uint16_t* quotients, uint16_t* flags, uint32_t* cycles) -> int {
+    return DivideBatch<true>(dividends, divisors, count, remainders, quotients, flags, cycles);
+}
+
+auto m68k_instruction_cycles(uint16_t opcode, uint32_t destination, uint16_t source) -> uint32_t {
+    return InstructionCycles(opcode, destination, source);
+}
+
+}
@@ -0,0 +1,66 @@
+#ifndef M68K_DIVISION_C_H
+#define M68K_DIVISION_C_H
+
+/*
+ * C interface of the shared library 68000_Division_C, for loading through an FFI.
+ *
+ * Only plain integers, pointers and the structure below cross the interface. Everything is
+ * caller-owned and nothing is allocated. The batch functions read count operands from the input arrays
+ * and write count results into the output arrays in place, with the engines of 68000_Batch.h.
+ * Results hold what the MC68000 registers would after the instruction, with the dividend in Dx and the
+ * divisor in Dy: the remainder (upper word of Dx), the quotient (lower word of Dx), the flags (X N Z V C
+ * in bits 4 to 0) and the cycles of the microcode, without the effective address or exception time.
+ *
+ * Additions keep the existing functions and the layout of m68k_division_result unchanged,
+ * m68k_abi_version reports M68K_DIVISION_ABI_VERSION of the library that was loaded.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(M68K_DIVISION_C_BUILD)
+#define M68K_DIVISION_API __declspec(dllexport)
+#else
+#define M68K_DIVISION_API __declspec(dllimport)
+#endif
+#else
+#define M68K_DIVISION_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define M68K_DIVISION_ABI_VERSION 1
+
+#define M68K_OK 0
+#define M68K_INVALID_ARGUMENT (-1) /* A null pointer with a non-zero count */
+
+typedef struct m68k_division_result {
+    uint16_t remainder;
+    uint16_t quotient;
+    uint16_t flags;
+    uint16_t reserved; /* 0 */
+    uint32_t cycles;
+} m68k_division_result;
+
+M68K_DIVISION_API uint32_t m68k_abi_version(void);
+
+M68K_DIVISION_API int m68k_divu(uint32_t dividend, uint16_t divisor, m68k_division_result* result);
+M68K_DIVISION_API int m68k_divs(uint32_t dividend, uint16_t divisor, m68k_division_result* result);
+
+/* Structure of arrays, every array holds count elements */
+M68K_DIVISION_API int m68k_divu_batch(const uint32_t* dividends, const uint16_t* divisors, size_t count,
+                                      uint16_t* remainders, uint16_t* quotients, uint16_t* flags, uint32_t* cycles);
+M68K_DIVISION_API int m68k_divs_batch(const uint32_t* dividends, const uint16_t* divisors, size_t count,
+                                      uint16_t* remainders, uint16_t* quotients, uint16_t* flags, uint32_t* cycles);
+
+/* Whole instruction cycles of DIVU, DIVS, MULU or MULS from the opcode, see 68000_Timing.h, 0 for other opcodes */
+M68K_DIVISION_API uint32_t m68k_instruction_cycles(uint16_t opcode, uint32_t destination, uint16_t source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,14 +1,101 @@
+#include <utility>
+
 #include "68000.h"
+#include "68000_Dispatch.h"
+#include "68000_Profile.h"
+#include "68000_Trace.h"
+#include "68000_TraceFile.h"
+
+namespace {
+
+// One iteration of the main loop on the absolute values, DVS09/0A and DVS0C, then DVS0D and DVS0F unless it is
+// the last. microword is DVS09 or DVS0A on entry, and the next one on exit
+template<bool Last, typename TraceSink>
+[[gnu::always_inline]] inline auto DivsIteration(MC68000& mc68000, TraceSink& sink) -> void {
+    mc68000.cycles += 2u;
+    mc68000.au = mc68000.au - 1u;
+    mc68000.AluOp_SLAAx((mc68000.microword == DVS0A) ? 1u : 0u);
+    Trace(sink, mc68000);
+    mc68000.cycles += 2u;
+    mc68000.atl = mc68000.alu;
+    mc68000.AluOp_SUB(mc68000.alu, mc68000.alub);
+    if constexpr (Last) {
+        mc68000.microword = DVS0E;
+    } else {
+        // DVS0D, DVS0F after it on a borrow
+        const auto borrow = (mc68000.atl < mc68000.alub) ? 1u : 0u;
+        mc68000.cycles += 2u + 2u * borrow;
+        if (borrow) {
+            mc68000.AluOp_AND(mc68000.atl, 0xFFFFu);
+        }
+        mc68000.microword = borrow ? DVS09 : DVS0A;
+    }
+}
+
+template<typename TraceSink, std::size_t... Iterations>
+[[gnu::always_inline]] inline auto DivsLoop(MC68000& mc68000, TraceSink& sink, std::index_sequence<Iterations...>) -> void {
+    (DivsIteration<Iterations + 1u == sizeof...(Iterations)>(mc68000, sink), ...);
+}
+
+}
+
+template<typename TraceSink>
+auto MC68000::ExecuteDivs(TraceSink& sink) -> void {
+    microword = DVS01;
+    ContinueDivs<false, false>(sink, 0u);
+}
 
-auto MC68000::ExecuteDivs() -> void {
+template<typename TraceSink>
+auto MC68000::RunDivs(TraceSink& sink, uint32_t maxCycles) -> bool {
+    return ContinueDivs<true, false>(sink, cycles + maxCycles);
+}
+
+template<typename TraceSink>
+auto MC68000::ExecuteDivsFused(TraceSink& sink) -> void {
     microword = DVS01;
+    ContinueDivs<false, true>(sink, 0u);
+}
+
+template<bool Budgeted, bool Fused, typename TraceSink>
+auto MC68000::ContinueDivs(TraceSink& sink, uint32_t deadline) -> bool {
+    static_assert(!(Budgeted && Fused), "The fused loop can't stop part way through");
+    auto previous = static_cast<uint16_t>(MICROWORD_COUNT); // None, for the trace sink
+    // A sink that sees every microword needs them run one by one
+    constexpr auto fuse = Fused && !requires { sink.Step(previous, microword); } && !requires { sink.Microcycle(*this); };
+#if M68K_USE_THREADED_DISPATCH
+    static void* const dispatch[MICROWORD_COUNT] = {
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_DVUM4, // DVUR1, DVUM2, DVUM3, DVUM4
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUM5, DVUM6, DVUM7, DVUM8
+        &&microword_exit, &&microword_DVUMA, &&microword_exit, &&microword_exit, // DVUM9, DVUMA, DVUMB, DVUMC
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUMD, DVUME, DVUMF, DVUM0
+        &&microword_DVUMZ, &&microword_DVS01, &&microword_DVS03, &&microword_DVS04, // DVUMZ, DVS01, DVS03, DVS04
+        &&microword_DVS05, &&microword_DVS06, &&microword_DVS07, &&microword_DVS08, // DVS05, DVS06, DVS07, DVS08
+        &&microword_DVS09, &&microword_DVS0A, &&microword_DVS0C, &&microword_DVS0D, // DVS09, DVS0A, DVS0C, DVS0D
+        &&microword_DVS0E, &&microword_DVS0F, &&microword_DVS10, &&microword_DVS11, // DVS0E, DVS0F, DVS10, DVS11
+        &&microword_DVS12, &&microword_DVS13, &&microword_DVS14, &&microword_DVS15, // DVS12, DVS13, DVS14, DVS15
+        &&microword_DVS16, &&microword_DVS17, &&microword_DVS1A, &&microword_DVS1B, // DVS16, DVS17, DVS1A, DVS1B
+        &&microword_DVS1C, &&microword_DVS1D, &&microword_DVS1E, &&microword_DVS1F, // DVS1C, DVS1D, DVS1E, DVS1F
+        &&microword_DVS20, &&microword_LEAA2, &&microword_exit, &&microword_exit, // DVS20, LEAA2, TRAP0, A1
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // MULR1, MULM2, MULM3, MULM4
+        &&microword_exit, &&microword_exit, // MULM5, MULM6
+    };
+    DISPATCH();
+    { // Blocks in place of the loop and switch of the default dispatch
+        {
+#else
     while (true) {
+        if (M68K_PAUSED()) {
+            SyncFlags();
+            return false; // Resumed from microword by the next call
+        }
         cycles += 2u;
+        Step(sink, previous, *this);
         switch (microword) {
+#endif
             /*
              * Division by zero, take absolute values, check for unsigned overflow
              */
-            case DVS01: {
+            MICROWORD(DVS01): {
                 // Sets up test for division by zero and checking sign of divisor
                 pc = au;
                 alue = rxdl; // lower 16-bits of dividend
@@ -16,9 +103,9 @@ auto MC68000::ExecuteDivs() -> void {
                 ath = rydl; // 16-bit divisor
                 AluOp_AND(rydl, 0xFFFFu);
                 microword = DVS03;
-                break;
+                DISPATCH();
             }
-            case DVS03: {
+            MICROWORD(DVS03): {
                 // Subtracts the divisor from zero, so we can take the absolute value
                 // Branches to a trap for zero dividend, or different microwords
                 // depending on the sign of the divisor
@@ -29,9 +116,9 @@ auto MC68000::ExecuteDivs() -> void {
                             (oldFlags & FLAG_N) ?
                             DVS05 : // Negative divisor
                             DVS04;  // Positive divisor
-                break;
+                DISPATCH();
             }
-            case DVS04: {
+            MICROWORD(DVS04): {
                 // This microword sets up the loop counter and tests the msb of the dividend
                 // Note: uses the same nanoword as DVUM3
                 // Callers: DVS03 (positive divisor)
@@ -39,9 +126,9 @@ auto MC68000::ExecuteDivs() -> void {
                 atl = rxdh; // upper 16-bits of dividend
                 AluOp_AND(rxdh, 0xFFFFu); // upper 16-bits of dividend
                 microword = DVS06;
-                break;
+                DISPATCH();
             }
-            case DVS05: {
+            MICROWORD(DVS05): {
                 // This microword sets up the loop counter and tests the msb of the dividend
                 // And negates a negative divisor
                 // Callers: DVS03 (negative divisor)
@@ -50,74 +137,79 @@ auto MC68000::ExecuteDivs() -> void {
                 alub = alu; // update alub with negated (i.e. now positive) divisor
                 AluOp_AND(rxdh, 0xFFFFu); // upper 16-bits of dividend
                 microword = DVS06;
-                break;
+                DISPATCH();
             }
-            case DVS06: {
+            MICROWORD(DVS06): {
                 // Microword negates the lower bits of the dividend
                 // Callers: DVS04, DVS05
                 const auto oldFlags = AluOp_SUB(0u, rxdl);
                 microword = (oldFlags & FLAG_N) ?
                             DVS10 : // Negative dividend
                             DVS07; // Positive dividend
-                break;
+                DISPATCH();
             }
-            case DVS07: {
+            MICROWORD(DVS07): {
                 // Microword sets up the overflow test when the dividend was positive
                 // Callers: DVS06
                 AluOp_SUB(atl, alub); // upper 16-bits of dividend - divisor
                 microword = DVS08;
-                break;
+                DISPATCH();
             }
-            case DVS08: {
+            MICROWORD(DVS08): {
                 // Microword sets the N flag for the MSB of the absolute dividend
                 // Callers: DVS07
                 const auto oldFlags = AluOp_AND(atl, 0xFFFFu);
-                Print();
+                Trace(sink, *this);
                 microword = (oldFlags & FLAG_C) ?
                             DVS09 : // Main division loop
                             DVUMZ; // Overflow handling
-                break;
-            }
-            case DVS10: {
+                if constexpr (fuse) {
+                    if (microword == DVS09) {
+                        DivsLoop(*this, sink, std::make_index_sequence<16u>{}); // On to DVS0E
+                    }
+                }
+                DISPATCH();
+            }
+            MICROWORD(DVS10): {
                 // Microword continues the process of negating a negative dividend
                 alue = alu; // Dividend was negative so move absolute lower 16-bits into alu extender
                 AluOp_SUBX(0u, rxdh); // Negate upper bits of dividend
                 microword = DVS11;
-                break;
+                DISPATCH();
             }
-            case DVS11: {
+            MICROWORD(DVS11): {
                 // Microword sets up the overflow test when the dividend was negative
                 // Callers: DVS10
                 atl = alu; // We want the absolute dividend stored in atl
                 AluOp_SUB(atl, alub); // upper 16-bits of dividend - divisor
                 microword = DVS08;
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Main division loop
                  */
-            case DVS09: {
+            MICROWORD(DVS09): {
                 // Logical shift left with 0 into lsb
                 // Decrement counter
                 // Callers: DVS08, DVS0F
                 au = au - 1;
                 AluOp_SLAAx(0u);
-                Print();
+                Trace(sink, *this);
                 microword = DVS0C;
-                break;
+                DISPATCH();
             }
-            case DVS0A: {
+            MICROWORD(DVS0A): {
                 // Logical shift left with 1 into lsb
                 // Decrement counter
                 // Callers: DVS0D
                 au = au - 1;
                 AluOp_SLAAx(1u);
-                Print();
+                Trace(sink, *this);
                 microword = DVS0C;
-                break;
+                DISPATCH();
             }
-            case DVS0C: {
+            MICROWORD(DVS0C): {
                 // Subtracts divisor from dividend
                 // Callers: DVS09, DVS0A
                 atl = alu; // Remember the current dividend/remainder
@@ -125,64 +217,64 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (au != 0) ?
                             DVS0D : // Loop hasn't expired
                             DVS0E; // Loop has expired
-                break;
+                DISPATCH();
             }
-            case DVS0D: {
+            MICROWORD(DVS0D): {
                 // Idle wait
                 // Callers: DVS0C
-                const auto oldFlags = flags;
+                const auto oldFlags = Flags();
                 microword = (oldFlags & FLAG_C) ?
                             DVS0F : // Restore previous dividend/remainder
                             DVS0A; // Put 1 into the quotient
-                break;
+                DISPATCH();
             }
-            case DVS0F: {
+            MICROWORD(DVS0F): {
                 // Restores the previous dividend
                 AluOp_AND(atl, 0xFFFFu);
                 microword = DVS09;
-                break;
+                DISPATCH();
             }
-            case DVS0E: {
+            MICROWORD(DVS0E): {
                 // Idle wait
                 // Callers: DVS0C
-                const auto oldFlags = flags;
+                const auto oldFlags = Flags();
                 microword = (oldFlags & FLAG_C) ?
                             DVS12 : // least significant bit of quotient is 0
                             DVS13; // leas significant bit of quotient is 1
-                break;
+                DISPATCH();
             }
-            case DVS12: {
+            MICROWORD(DVS12): {
                 // Sets the least significant bit of the quotient to 0
                 // Callers: DVS0E
                 AluOp_SLAAx(0u);
-                Print();
+                Trace(sink, *this);
                 microword = DVS14;
-                break;
+                DISPATCH();
             }
-            case DVS13: {
+            MICROWORD(DVS13): {
                 // Sets the least significant bit of the quotient to 1
                 // Overwrites the address temporary low with the correct remainder
                 // Callers: DVS0E
                 atl = alu;
                 AluOp_SLAAx(1u);
-                Print();
+                Trace(sink, *this);
                 microword = DVS14;
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Tests the signs of the original divisor and dividend to fix
                  * quotient and remainder signs
                  */
-            case DVS14: {
+            MICROWORD(DVS14): {
                 // Tests the sign of the original divisor
                 // Callers: DVS12, DVS13
                 AluOp_AND(ath, 0xFFFFu);
-                Print();
+                Trace(sink, *this);
                 microword = DVS15;
-                break;
+                DISPATCH();
             }
-            case DVS15: {
+            MICROWORD(DVS15): {
                 // Tests the sign of the original dividend
                 // Move quotient from alue into alub
                 // Callers: DVS14
@@ -191,9 +283,9 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (oldFlags & FLAG_N) ?
                             DVS1D : // Negative divisor (< 0)
                             DVS16; //  Positive divisor (>= 0)
-                break;
+                DISPATCH();
             }
-            case DVS16: {
+            MICROWORD(DVS16): {
                 // Positive divisor: Test sign of quotient
                 // Callers: DVS15
                 ath = atl; // Move remainder into address temporary high
@@ -201,9 +293,9 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (oldFlags & FLAG_N) ?
                             DVS1A : // Positive divisor, negative dividend
                             DVS17; // Positive divisor, positive dividend
-                break;
+                DISPATCH();
             }
-            case DVS1D: {
+            MICROWORD(DVS1D): {
                 // Negative divisor: Test sign of quotient
                 // Callers: DVS15
                 ath = atl; // Move remainder into address temporary high
@@ -211,13 +303,13 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (oldFlags & FLAG_N) ?
                             DVS1E : // Negative divisor, negative dividend
                             DVS1F; // Negative divisor, positive dividend
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Positive divisor, positive dividend
                  */
-            case DVS17: {
+            MICROWORD(DVS17): {
                 // Computes final set of flags
                 // Callers: DVS16
                 atl = alu;
@@ -225,20 +317,20 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (oldFlags & FLAG_N) ?
                             DVUMA : // Negative quotient, should be positive: overflow
                             LEAA2;
-                break;
+                DISPATCH();
             }
 
                 /*
                 * Positive divisor, negative dividend
                 */
-            case DVS1A: {
+            MICROWORD(DVS1A): {
                 // Negates the quotient (since dividend and divisor have opposing signs)
                 // Callers: DVS16
                 AluOp_SUB(0u, alub);
                 microword = DVS1B;
-                break;
+                DISPATCH();
             }
-            case DVS1B: {
+            MICROWORD(DVS1B): {
                 // Negates the remainder (since remainder and dividend are to have the same sign)
                 // Callers: DVS1A
                 alub = alu; // Update alub with negated quotient
@@ -247,28 +339,28 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = ((oldFlags & (FLAG_N | FLAG_Z)) == 0u) ?
                             DVUM4 : // Positive quotient (> 0) when we expected a negative one, overflow
                             DVS1C; // quotient is less than or equal to zero, proceed as normal
-                break;
+                DISPATCH();
             }
-            case DVS1C: {
+            MICROWORD(DVS1C): {
                 // Computes final set of flags
                 // Callers: DVS1B, DVS1E
                 ath = alu; // Update remainder with negated copy
                 AluOp_AND(alub, 0xFFFFu);
                 microword = LEAA2;
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Negative divisor, positive dividend
                  */
-            case DVS1F: {
+            MICROWORD(DVS1F): {
                 // Negates the quotient (since divisor and dividend have opposing signs)
                 // Callers: DVS1D
                 AluOp_SUB(0u, alub);
                 microword = DVS20;
-                break;
+                DISPATCH();
             }
-            case DVS20: {
+            MICROWORD(DVS20): {
                 atl = alu; // Update quotient with negated value
                 // Note: this isn't stated in the microde listing, but then the final flags would be wrong?
                 alub = alu; // Update quotient with negated value
@@ -276,13 +368,13 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = ((oldFlags & (FLAG_N | FLAG_Z)) == 0u) ?
                             DVUMA : // Negated quotient is positive, and we expected a negative one, overflow
                             LEAA2;
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Negative divisor, negative dividend
                  */
-            case DVS1E: {
+            MICROWORD(DVS1E): {
                 // Negate the remainder, since remainder has the same sign as the dividend
                 // Callers: DVS1D
                 alub = alu; // move quotient into alu buffer
@@ -291,40 +383,90 @@ auto MC68000::ExecuteDivs() -> void {
                 microword = (oldFlags & FLAG_N) ?
                             DVUM4 : // Divisor and dividend have opposing signs, quotient is negative, expected positive, overflow
                             DVS1C;
-                break;
+                DISPATCH();
             }
 
                 /*
                  * Write the results back to the registers,
                  * prepare to return control to the next macro instruction
                  */
-            case LEAA2: {
+            MICROWORD(LEAA2): {
                 // Callers: DVS17, DVS1C, DVS20
                 rxdh = ath;
                 rxdl = atl;
                 microword = A1;
-                break;
+                DISPATCH();
             }
                 /*
                  * Exits
                  */
-            case DVUM4: [[fallthrough]];
-            case DVUMZ: {
+            MICROWORD(DVUM4):
+            MICROWORD(DVUMZ): {
                 // overflow detected
                 // sets up the program counter for read
                 microword = DVUMA;
-                break;
+                DISPATCH();
             }
-            case DVUMA:  {
+            MICROWORD(DVUMA): {
                 microword = A1;
-                break;
+                DISPATCH();
+            }
+#if M68K_USE_THREADED_DISPATCH
+            microword_pause: {
+                SyncFlags();
+                return false; // Resumed from microword by the next call
             }
+            microword_exit:
+#else
             case TRAP0: [[fallthrough]]; // division by zero
             case A1: // control has been returned to next macro instruction
-            default: {
+            default:
+#endif
+            {
                 cycles -= 2u; // Discount these cycles
-                return;
+                SyncFlags();
+                return true;
             }
         }
     }
-}
\ No newline at end of file
+}
+
+template auto MC68000::ExecuteDivs(NullTraceSink&) -> void;
+template auto MC68000::ExecuteDivs(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteDivs(RingTraceSink&) -> void;
+template auto MC68000::ExecuteDivs(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteDivs(BinaryTraceSink&) -> void;
+template auto MC68000::RunDivs(NullTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivs(ConsoleTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivs(RingTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivs(ProfileTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivs(BinaryTraceSink&, uint32_t) -> bool;
+template auto MC68000::ExecuteDivsFused(NullTraceSink&) -> void;
+template auto MC68000::ExecuteDivsFused(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteDivsFused(RingTraceSink&) -> void;
+template auto MC68000::ExecuteDivsFused(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteDivsFused(BinaryTraceSink&) -> void;
+
+// The registers are copied into a local that doesn't escape, so once the main loop is inlined
+// they can be kept in machine registers for the whole instruction and are written back once at the exit
+[[gnu::flatten]] auto MC68000::ExecuteDivs() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteDivs(sink);
+    *this = local;
+}
+
+[[gnu::flatten]] auto MC68000::RunDivs(uint32_t maxCycles) -> bool {
+    NullTraceSink sink;
+    auto local = *this;
+    const auto done = local.RunDivs(sink, maxCycles);
+    *this = local;
+    return done;
+}
+
+[[gnu::flatten]] auto MC68000::ExecuteDivsFused() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteDivsFused(sink);
+    *this = local;
+}
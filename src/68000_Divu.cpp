@@ -1,11 +1,100 @@
+#include <utility>
+
 #include "68000.h"
+#include "68000_Dispatch.h"
+#include "68000_Profile.h"
+#include "68000_Trace.h"
+#include "68000_TraceFile.h"
+
+namespace {
+
+// One iteration of the main loop, DVUM5/6 and DVUM7/8, then DVUMB and DVUME unless it is the last.
+// microword is DVUM5 or DVUM6 on entry, and the next one on exit
+template<bool Last, typename TraceSink>
+[[gnu::always_inline]] inline auto DivuIteration(MC68000& mc68000, TraceSink& sink) -> void {
+    const auto msb = static_cast<uint32_t>(mc68000.alu >> 15u); // N of the last operation, DVUM5/6 branch on it
+    mc68000.cycles += 2u;
+    mc68000.au = mc68000.au - 1u;
+    mc68000.AluOp_SLAAx((mc68000.microword == DVUM6) ? 1u : 0u);
+    Trace(sink, mc68000);
+    mc68000.cycles += 2u;
+    mc68000.atl = mc68000.alu;
+    mc68000.AluOp_SUB(mc68000.alu, mc68000.alub);
+    if constexpr (Last) {
+        mc68000.microword = msb ? DVUM9 : DVUMC;
+    } else {
+        // DVUMB after DVUM8, DVUME after it on a borrow
+        const auto borrow = (mc68000.atl < mc68000.alub) ? 1u : 0u;
+        const auto restore = borrow & (msb ^ 1u);
+        mc68000.cycles += 2u * (msb ^ 1u) + 2u * restore;
+        if (restore) {
+            mc68000.AluOp_AND(mc68000.atl, 0xFFFFu);
+        }
+        mc68000.microword = restore ? DVUM5 : DVUM6;
+    }
+}
 
-auto MC68000::ExecuteDivu() -> void {
+template<typename TraceSink, std::size_t... Iterations>
+[[gnu::always_inline]] inline auto DivuLoop(MC68000& mc68000, TraceSink& sink, std::index_sequence<Iterations...>) -> void {
+    (DivuIteration<Iterations + 1u == sizeof...(Iterations)>(mc68000, sink), ...);
+}
+
+}
+
+template<typename TraceSink>
+auto MC68000::ExecuteDivu(TraceSink& sink) -> void {
     microword = DVUR1;
+    ContinueDivu<false, false>(sink, 0u);
+}
+
+template<typename TraceSink>
+auto MC68000::RunDivu(TraceSink& sink, uint32_t maxCycles) -> bool {
+    return ContinueDivu<true, false>(sink, cycles + maxCycles);
+}
+
+template<typename TraceSink>
+auto MC68000::ExecuteDivuFused(TraceSink& sink) -> void {
+    microword = DVUR1;
+    ContinueDivu<false, true>(sink, 0u);
+}
+
+template<bool Budgeted, bool Fused, typename TraceSink>
+auto MC68000::ContinueDivu(TraceSink& sink, uint32_t deadline) -> bool {
+    static_assert(!(Budgeted && Fused), "The fused loop can't stop part way through");
+    auto previous = static_cast<uint16_t>(MICROWORD_COUNT); // None, for the trace sink
+    // A sink that sees every microword needs them run one by one
+    constexpr auto fuse = Fused && !requires { sink.Step(previous, microword); } && !requires { sink.Microcycle(*this); };
+#if M68K_USE_THREADED_DISPATCH
+    static void* const dispatch[MICROWORD_COUNT] = {
+        &&microword_DVUR1, &&microword_DVUM2, &&microword_DVUM3, &&microword_DVUM4, // DVUR1, DVUM2, DVUM3, DVUM4
+        &&microword_DVUM5, &&microword_DVUM6, &&microword_DVUM7, &&microword_DVUM8, // DVUM5, DVUM6, DVUM7, DVUM8
+        &&microword_DVUM9, &&microword_DVUMA, &&microword_DVUMB, &&microword_DVUMC, // DVUM9, DVUMA, DVUMB, DVUMC
+        &&microword_DVUMD, &&microword_DVUME, &&microword_DVUMF, &&microword_DVUM0, // DVUMD, DVUME, DVUMF, DVUM0
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUMZ, DVS01, DVS03, DVS04
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS05, DVS06, DVS07, DVS08
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS09, DVS0A, DVS0C, DVS0D
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS0E, DVS0F, DVS10, DVS11
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS12, DVS13, DVS14, DVS15
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS16, DVS17, DVS1A, DVS1B
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS1C, DVS1D, DVS1E, DVS1F
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS20, LEAA2, TRAP0, A1
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // MULR1, MULM2, MULM3, MULM4
+        &&microword_exit, &&microword_exit, // MULM5, MULM6
+    };
+    DISPATCH();
+    { // Blocks in place of the loop and switch of the default dispatch
+        {
+#else
     while (true) {
+        if (M68K_PAUSED()) {
+            SyncFlags();
+            return false; // Resumed from microword by the next call
+        }
         cycles += 2u;
+        Step(sink, previous, *this);
         switch (microword) {
-            case DVUR1: {
+#endif
+            MICROWORD(DVUR1): {
                 // This mircoword sets up the test for division by zero
                 pc = au;
                 alue = rxdl; // lower 16-bits of dividend
@@ -13,56 +102,61 @@ auto MC68000::ExecuteDivu() -> void {
                 ath = rydl; // divisor
                 AluOp_AND(rydl, 0xFFFFu);
                 microword = DVUM2;
-                break;
+                DISPATCH();
             }
-            case DVUM2: {
+            MICROWORD(DVUM2): {
                 // This microword sets up the overflow test
                 // Callers: DVUR1
                 const auto oldFlags = AluOp_SUB(rxdh, alub); // divisor - upper 16-bits of dividend
                 microword = (oldFlags & FLAG_Z) ?
                             TRAP0 : // Division by zero handling
                             DVUM3; // Move to test msb of dividend, set up loop counter
-                break;
+                DISPATCH();
             }
-            case DVUM3: {
+            MICROWORD(DVUM3): {
                 // This microword sets up the loop counter and tests the msb of the dividend
                 // Callers: DVUM2
                 au = 15u + 1u; // loop counter
                 atl = rxdh; // upper 16-bits of dividend
                 const auto oldFlags = AluOp_AND(rxdh, 0xFFFFu); // upper 16-bits of dividend
-                Print();
+                Trace(sink, *this);
                 microword = (oldFlags & FLAG_C) ?
                             DVUM5 : // Main division loop
                             DVUM4; // Overflow handling
-                break;
+                if constexpr (fuse) {
+                    if (microword == DVUM5) {
+                        DivuLoop(*this, sink, std::make_index_sequence<16u>{}); // On to DVUM9 or DVUMC
+                    }
+                }
+                DISPATCH();
             }
-            case DVUM5: {
+            MICROWORD(DVUM5): {
                 // This microword shifts the dividend left 1 bit
                 // and puts a 0 into the LSB of the dividend
                 // Decrements the loop counter
                 // Callers: DVUM3, DVUME
                 au = au - 1u;
                 const auto oldFlags = AluOp_SLAAx(0u);
-                Print();
+                Trace(sink, *this);
                 microword = (oldFlags & FLAG_N) ?
                             DVUM7 : // If the most significant bit was a 1
                             DVUM8; // If the most significant bit was a 0
-                break;
+                DISPATCH();
             }
-            case DVUM6: {
+            MICROWORD(DVUM6): {
                 // This microword shifts the dividend left 1 bit
                 // and puts a 1 into the LSB of the dividend
                 // Decrements the loop counter
                 // Callers: DVUM7, DVUMB
                 au = au - 1u;
                 const auto oldFlags = AluOp_SLAAx(1u);
-                Print();
+                Trace(sink, *this);
                 microword = (oldFlags & FLAG_N) ?
                             DVUM7 : // If the most significant bit was a 1
                             DVUM8;  // If the most significant bit was a 0
-                break;
+                DISPATCH();
             }
-            case DVUM7: {
+            MICROWORD(DVUM7): {
                 // This microword subtracts the divisor from the upper 16 bits of the dividend
                 // Callers: DVUM5, DVUM6
                 atl = alu; // current remainder
@@ -70,9 +164,9 @@ auto MC68000::ExecuteDivu() -> void {
                 microword = (au != 0) ?
                             DVUM6 : // Loop hasn't expired
                             DVUM9; // Loop has expired
-                break;
+                DISPATCH();
             }
-            case DVUM8: {
+            MICROWORD(DVUM8): {
                 // This microword subtracts the divisor from the upper 16 bits of the dividend
                 // Note: this microword has the same nanoword origin as DVUM7
                 // Callers: DVUM5, DVUM6
@@ -81,28 +175,28 @@ auto MC68000::ExecuteDivu() -> void {
                 microword = (au != 0) ?
                             DVUMB : // Loop hasn't expired
                             DVUMC; // Loop has expired
-                break;
+                DISPATCH();
             }
-            case DVUM9: {
+            MICROWORD(DVUM9): {
                 // This microcode copies the remainder from the alu back to the original register
                 // And zeroes the alu
                 // Callers: DVUM7
                 rxdh = alu;
                 AluOp_AND(alu, 0u);
                 microword = DVUMD;
-                break;
+                DISPATCH();
             }
-            case DVUMB: {
+            MICROWORD(DVUMB): {
                 // This microcode is an idle wait
                 // It's needed to give time for the DVUM8 flag evaluation to complete
                 // Callers: DVUM8
-                const auto oldFlags = flags;
+                const auto oldFlags = Flags();
                 microword = (oldFlags & FLAG_C) ?
                             DVUME : // The divisor was greater than the dividend, restore old divisor
                             DVUM6; // The divisor was less than the dividend, 1 is required in the quotient
-                break;
+                DISPATCH();
             }
-            case DVUMC: {
+            MICROWORD(DVUMC): {
                 // This microcode copies the remainder from the alu back into the original register
                 // and zeroes the alu
                 // Note: this microword has the same nanoword origin as DVUM9
@@ -112,9 +206,9 @@ auto MC68000::ExecuteDivu() -> void {
                 microword = (oldFlags & FLAG_C) ?
                             DVUMF : // The last subtraction produced carry, so we need to fix up the remainder
                             DVUMD; // No need to fix up the remainder
-                break;
+                DISPATCH();
             }
-            case DVUMD: {
+            MICROWORD(DVUMD): {
                 // This microcode shifts left putting a 1-bit into the lsb of the alu extender
                 // It initiates the next instruction read
                 // Callers: DVUM9, DVUMC
@@ -122,16 +216,16 @@ auto MC68000::ExecuteDivu() -> void {
                 alub = alu;
                 AluOp_SLAAx(1u);
                 microword = DVUM0;
-                break;
+                DISPATCH();
             }
-            case DVUME: {
+            MICROWORD(DVUME): {
                 // This microword restores the previous dividend, setting the N flag
                 // Callers: DVUMB
                 AluOp_AND(atl, 0xFFFFu);
                 microword = DVUM5;
-                break;
+                DISPATCH();
             }
-            case DVUMF: {
+            MICROWORD(DVUMF): {
                 // This mircoword restores the previous dividend to rx
                 // and shifts a zero into the least significant bit of the quotient
                 // Callers: DVUMC
@@ -140,33 +234,83 @@ auto MC68000::ExecuteDivu() -> void {
                 rxdh = atl;
                 AluOp_SLAAx(0u);
                 microword = DVUM0;
-                break;
+                DISPATCH();
             }
-            case DVUM0: {
+            MICROWORD(DVUM0): {
                 // this microword reads the next instruction word
                 // And sets the flags
                 // Callers: DVUMD, DVUMF
                 rxdl = alue;
                 AluOp_SUB(alue, alub);
                 microword = A1;
-                break;
+                DISPATCH();
             }
-            case DVUM4: {
+            MICROWORD(DVUM4): {
                 // overflow detected
                 // sets up the program counter for read
                 microword = DVUMA;
-                break;
+                DISPATCH();
             }
-            case DVUMA: {
+            MICROWORD(DVUMA): {
                 microword = A1;
-                break;
+                DISPATCH();
+            }
+#if M68K_USE_THREADED_DISPATCH
+            microword_pause: {
+                SyncFlags();
+                return false; // Resumed from microword by the next call
             }
+            microword_exit:
+#else
             case TRAP0: // division by zero
             case A1: // control has been returned to next macro instruction
-            default: {
+            default:
+#endif
+            {
                 cycles -= 2u; // Discount these cycles
-                return;
+                SyncFlags();
+                return true;
             }
         }
     }
-}
\ No newline at end of file
+}
+
+template auto MC68000::ExecuteDivu(NullTraceSink&) -> void;
+template auto MC68000::ExecuteDivu(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteDivu(RingTraceSink&) -> void;
+template auto MC68000::ExecuteDivu(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteDivu(BinaryTraceSink&) -> void;
+template auto MC68000::RunDivu(NullTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivu(ConsoleTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivu(RingTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivu(ProfileTraceSink&, uint32_t) -> bool;
+template auto MC68000::RunDivu(BinaryTraceSink&, uint32_t) -> bool;
+template auto MC68000::ExecuteDivuFused(NullTraceSink&) -> void;
+template auto MC68000::ExecuteDivuFused(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteDivuFused(RingTraceSink&) -> void;
+template auto MC68000::ExecuteDivuFused(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteDivuFused(BinaryTraceSink&) -> void;
+
+// The registers are copied into a local that doesn't escape, so once the main loop is inlined
+// they can be kept in machine registers for the whole instruction and are written back once at the exit
+[[gnu::flatten]] auto MC68000::ExecuteDivu() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteDivu(sink);
+    *this = local;
+}
+
+[[gnu::flatten]] auto MC68000::RunDivu(uint32_t maxCycles) -> bool {
+    NullTraceSink sink;
+    auto local = *this;
+    const auto done = local.RunDivu(sink, maxCycles);
+    *this = local;
+    return done;
+}
+
+[[gnu::flatten]] auto MC68000::ExecuteDivuFused() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteDivuFused(sink);
+    *this = local;
+}
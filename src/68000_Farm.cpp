@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "68000_Batch.h"
+#include "68000_Farm.h"
+
+struct DivisionFarm::Job {
+    DivisionInstruction instruction;
+    DivisionOperands operands;
+    DivisionResults results;
+    std::atomic<std::size_t> remaining; // Divisions not yet written
+    std::function<void()> completed;
+    std::promise<void> promise;
+};
+
+DivisionFarm::DivisionFarm(unsigned threads, std::size_t chunkSize, BatchIsa engine) :
+    chunkSize(std::max<std::size_t>(chunkSize, 1u)),
+    engine(engine) {
+    threads = std::max(threads, 1u);
+    for (auto i = 0u; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (auto i = 0u; i < threads; ++i) {
+        workers[i]->thread = std::thread(&DivisionFarm::WorkerLoop, this, i);
+    }
+}
+
+DivisionFarm::~DivisionFarm() {
+    Wait();
+    {
+        const std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+auto DivisionFarm::Submit(DivisionInstruction instruction, const DivisionOperands& operands, const DivisionResults& results) -> std::future<void> {
+    CheckBatchSpans(operands, results);
+    auto job = std::make_unique<Job>();
+    job->instruction = instruction;
+    job->operands = operands;
+    job->results = results;
+    auto future = job->promise.get_future();
+    Enqueue(std::move(job));
+    return future;
+}
+
+auto DivisionFarm::Submit(DivisionInstruction instruction, const DivisionOperands& operands, const DivisionResults& results,
+                          std::function<void()> completed) -> void {
+    CheckBatchSpans(operands, results);
+    auto job = std::make_unique<Job>();
+    job->instruction = instruction;
+    job->operands = operands;
+    job->results = results;
+    job->completed = std::move(completed);
+    Enqueue(std::move(job));
+}
+
+auto DivisionFarm::Wait() -> void {
+    std::unique_lock lock(mutex);
+    jobsCompleted.wait(lock, [this] { return pending == 0u; });
+}
+
+auto DivisionFarm::Statistics() const -> std::vector<FarmWorkerStatistics> {
+    std::vector<FarmWorkerStatistics> statistics;
+    for (const auto& worker : workers) {
+        statistics.push_back({
+            worker->divisions.load(std::memory_order_relaxed),
+            worker->chunks.load(std::memory_order_relaxed),
+            worker->steals.load(std::memory_order_relaxed),
+            static_cast<double>(worker->busyNanoseconds.load(std::memory_order_relaxed)) * 1e-9
+        });
+    }
+    return statistics;
+}
+
+auto DivisionFarm::Enqueue(std::unique_ptr<Job> owned) -> void {
+    const auto size = owned->operands.dividends.size();
+    if (size == 0u) {
+        if (owned->completed) {
+            owned->completed();
+        }
+        owned->promise.set_value();
+        return;
+    }
+    owned->remaining.store(size, std::memory_order_relaxed);
+    auto* job = owned.release();
+    // Counted before any worker can take a chunk of the job and subtract it
+    {
+        const std::lock_guard lock(mutex);
+        ++pending;
+        queued.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    // One slice per worker, or fewer for small jobs so no slice is below a chunk
+    const auto slices = std::min<std::size_t>(workers.size(), (size + chunkSize - 1u) / chunkSize);
+    for (std::size_t i = 0u; i < slices; ++i) {
+        auto& worker = *workers[i];
+        const std::lock_guard lock(worker.mutex);
+        worker.slices.push_back({ job, size * i / slices, size * (i + 1u) / slices });
+    }
+    workAvailable.notify_all();
+}
+
+auto DivisionFarm::NextChunk(std::size_t self, Slice& chunk) -> bool {
+    auto& own = *workers[self];
+    const auto take = [&](Slice& slice) {
+        chunk = { slice.job, slice.begin, std::min(slice.begin + chunkSize, slice.end) };
+        slice.begin = chunk.end;
+    };
+    {
+        const std::lock_guard lock(own.mutex);
+        if (!own.slices.empty()) {
+            take(own.slices.front());
+            if (own.slices.front().begin == own.slices.front().end) {
+                own.slices.pop_front();
+            }
+            return true;
+        }
+    }
+    for (std::size_t i = 1u; i < workers.size(); ++i) {
+        auto& victim = *workers[(self + i) % workers.size()];
+        Slice stolen;
+        {
+            const std::lock_guard lock(victim.mutex);
+            if (victim.slices.empty()) {
+                continue;
+            }
+            auto& back = victim.slices.back();
+            if (back.end - back.begin <= chunkSize) {
+                stolen = back;
+                victim.slices.pop_back();
+            } else {
+                const auto middle = back.begin + (back.end - back.begin) / 2u;
+                stolen = { back.job, middle, back.end };
+                back.end = middle;
+            }
+        }
+        own.steals.fetch_add(1u, std::memory_order_relaxed);
+        take(stolen);
+        if (stolen.begin != stolen.end) {
+            const std::lock_guard lock(own.mutex);
+            own.slices.push_front(stolen);
+        }
+        return true;
+    }
+    return false;
+}
+
+auto DivisionFarm::Run(Worker& worker, const Slice& chunk) -> void {
+    auto& job = *chunk.job;
+    const auto start = std::chrono::steady_clock::now();
+    const auto count = chunk.end - chunk.begin;
+    const DivisionOperands operands = {
+        job.operands.dividends.subspan(chunk.begin, count),
+        job.operands.divisors.subspan(chunk.begin, count)
+    };
+    const DivisionResults results = {
+        job.results.remainders.subspan(chunk.begin, count),
+        job.results.quotients.subspan(chunk.begin, count),
+        job.results.flags.subspan(chunk.begin, count),
+        job.results.cycles.subspan(chunk.begin, count)
+    };
+    if (job.instruction == DivisionInstruction::Divs) {
+        ExecuteDivsBatch(operands, results, engine);
+    } else {
+        ExecuteDivuBatch(operands, results, engine);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    worker.divisions.fetch_add(count, std::memory_order_relaxed);
+    worker.chunks.fetch_add(1u, std::memory_order_relaxed);
+    worker.busyNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                     std::memory_order_relaxed);
+
+    // Every result is written, the statistics are up to date before anyone waiting is released.
+    // The job stays pending while the callback runs, so Wait also waits for the callbacks
+    if (job.remaining.fetch_sub(count, std::memory_order_acq_rel) == count) {
+        if (job.completed) {
+            job.completed();
+        }
+        job.promise.set_value();
+        delete &job;
+        {
+            const std::lock_guard lock(mutex);
+            --pending;
+        }
+        jobsCompleted.notify_all();
+    }
+}
+
+auto DivisionFarm::WorkerLoop(std::size_t self) -> void {
+    auto& worker = *workers[self];
+    while (true) {
+        Slice chunk;
+        if (NextChunk(self, chunk)) {
+            queued.fetch_sub(chunk.end - chunk.begin, std::memory_order_relaxed);
+            Run(worker, chunk);
+            continue;
+        }
+        std::unique_lock lock(mutex);
+        workAvailable.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) != 0u; });
+        if (stopping && queued.load(std::memory_order_relaxed) == 0u) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "68000_Batch.h"
+
+// Runs queues of independent divisions on a pool of worker threads.
+//
+// A submitted job is split into one contiguous slice per worker. Workers take chunks from the front of
+// their own queue and, once it runs dry, steal the back half of another worker's slice, so jobs of fast
+// divisions (overflow, division by zero) and full 16 iteration ones keep every core busy.
+// Results are written straight into the caller's buffers, which must stay valid until the job completes.
+// Submit throws std::invalid_argument for spans the batch functions would reject (68000_Batch.h).
+// Nothing is allocated per division, only per job.
+
+struct FarmWorkerStatistics {
+    uint64_t divisions;
+    uint64_t chunks;
+    uint64_t steals; // Slices taken from other workers
+    double busySeconds; // Time spent running divisions
+
+    auto DivisionsPerSecond() const -> double {
+        return (busySeconds > 0.0) ? static_cast<double>(divisions) / busySeconds : 0.0;
+    }
+};
+
+class DivisionFarm {
+public:
+    // The engine runs each chunk, Scalar runs MC68000::ExecuteDivu/ExecuteDivs
+    explicit DivisionFarm(unsigned threads = std::thread::hardware_concurrency(),
+                          std::size_t chunkSize = 4096u,
+                          BatchIsa engine = BatchIsa::Scalar);
+    // Waits for the submitted jobs
+    ~DivisionFarm();
+
+    DivisionFarm(const DivisionFarm&) = delete;
+    auto operator=(const DivisionFarm&) -> DivisionFarm& = delete;
+
+    // The future becomes ready once every result of the job has been written
+    auto Submit(DivisionInstruction, const DivisionOperands&, const DivisionResults&) -> std::future<void>;
+    // The callback runs on the worker that finishes the job, before the job stops counting as pending.
+    // It must not call Wait or block on other jobs of the farm, that would deadlock
+    auto Submit(DivisionInstruction, const DivisionOperands&, const DivisionResults&, std::function<void()> completed) -> void;
+
+    // Blocks until every job submitted so far has completed and its callback has returned
+    auto Wait() -> void;
+
+    auto Threads() const -> unsigned { return static_cast<unsigned>(workers.size()); }
+    auto Statistics() const -> std::vector<FarmWorkerStatistics>;
+
+private:
+    struct Job;
+
+    // Divisions [begin, end) of a job
+    struct Slice {
+        Job* job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Slice> slices; // The owner takes from the front, thieves from the back
+        std::atomic<uint64_t> divisions{};
+        std::atomic<uint64_t> chunks{};
+        std::atomic<uint64_t> steals{};
+        std::atomic<uint64_t> busyNanoseconds{};
+        std::thread thread;
+    };
+
+    auto Enqueue(std::unique_ptr<Job>) -> void;
+    auto NextChunk(std::size_t self, Slice&) -> bool;
+    auto Run(Worker&, const Slice&) -> void;
+    auto WorkerLoop(std::size_t self) -> void;
+
+    std::size_t chunkSize;
+    BatchIsa engine;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex mutex; // Guards pending, stopping and the wakeups
+    std::condition_variable workAvailable;
+    std::condition_variable jobsCompleted;
+    std::atomic<uint64_t> queued{}; // Divisions not yet taken by a worker, workers sleep when 0
+    uint64_t pending{}; // Jobs not yet completed
+    bool stopping{};
+};
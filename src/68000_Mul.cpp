@@ -0,0 +1,189 @@
+#include "68000.h"
+#include "68000_Dispatch.h"
+#include "68000_Profile.h"
+#include "68000_Trace.h"
+#include "68000_TraceFile.h"
+
+// MULU and MULS of two data registers, MULx Dy,Dx, from sheet D of the listing.
+//
+// The multiplier is shifted right out of alue one bit per MULM4 while the product is shifted into it
+// from alu. MULU adds the multiplicand to alu (MULM3) for every 1 bit of the multiplier.
+// MULS recodes the multiplier with Booth's algorithm, looking at each bit and the one below it
+// (a 0 below bit 0): 01 adds the multiplicand (MULM3) and 10 subtracts it (MULM5).
+// Either way every add or subtract costs one extra microword on top of the 16 MULM4.
+//
+// The listing doesn't reproduce the row of Figure 17 for the multiply instructions, so
+//     the add and subtract of the loop leave the condition codes alone, the bit they carry into the
+//     msb of the 17 bit partial product is kept in extend for the shift
+//     MULM6 sets N and Z from the 32 bit product, clears V and C and leaves X, as the instruction does
+
+template<typename TraceSink>
+auto MC68000::ExecuteMulu(TraceSink& sink) -> void {
+    ExecuteMul<false>(sink);
+}
+
+template<typename TraceSink>
+auto MC68000::ExecuteMuls(TraceSink& sink) -> void {
+    ExecuteMul<true>(sink);
+}
+
+template<bool Muls, typename TraceSink>
+auto MC68000::ExecuteMul(TraceSink& sink) -> void {
+    microword = MULR1;
+    auto previous = static_cast<uint16_t>(MICROWORD_COUNT); // None, for the trace sink
+    auto extend = 0u; // Shifted into the msb of alu by the next MULM4
+#if M68K_USE_THREADED_DISPATCH
+    constexpr auto Budgeted = false; // Runs to completion, extend isn't kept in MC68000 to resume from
+    constexpr auto deadline = 0u;
+    static void* const dispatch[MICROWORD_COUNT] = {
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUR1, DVUM2, DVUM3, DVUM4
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUM5, DVUM6, DVUM7, DVUM8
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUM9, DVUMA, DVUMB, DVUMC
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUMD, DVUME, DVUMF, DVUM0
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVUMZ, DVS01, DVS03, DVS04
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS05, DVS06, DVS07, DVS08
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS09, DVS0A, DVS0C, DVS0D
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS0E, DVS0F, DVS10, DVS11
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS12, DVS13, DVS14, DVS15
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS16, DVS17, DVS1A, DVS1B
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS1C, DVS1D, DVS1E, DVS1F
+        &&microword_exit, &&microword_exit, &&microword_exit, &&microword_exit, // DVS20, LEAA2, TRAP0, A1
+        &&microword_MULR1, &&microword_MULM2, &&microword_MULM3, &&microword_MULM4, // MULR1, MULM2, MULM3, MULM4
+        &&microword_MULM5, &&microword_MULM6, // MULM5, MULM6
+    };
+    DISPATCH();
+    { // Blocks in place of the loop and switch of the default dispatch
+        {
+#else
+    while (true) {
+        cycles += 2u;
+        Step(sink, previous, *this);
+        switch (microword) {
+#endif
+            MICROWORD(MULR1): {
+                // This microword loads the multiplicand into alub and the multiplier into alue,
+                // clears the upper half of the product and sets up the loop counter
+                ath = au >> 16u; // Address of the next instruction word
+                atl = au;
+                alub = rxdl; // multiplicand
+                alue = rydl; // multiplier
+                AluOp_AND(0u, 0xFFFFu);
+                au = 15u; // loop counter
+                microword = MULM2;
+                DISPATCH();
+            }
+            MICROWORD(MULM2): {
+                // This microword tests bit 0 of the multiplier
+                // Callers: MULR1
+                rxdl = alu;
+                microword = (alue & 1u) ?
+                            (Muls ? MULM5 : MULM3) : // Bit 0 is 1, the bit below it is taken as 0
+                            MULM4;
+                DISPATCH();
+            }
+            MICROWORD(MULM3): {
+                // This microword adds the multiplicand to the upper half of the product
+                // Callers: MULM2, MULM4
+                if constexpr (Muls) {
+                    const auto sum = static_cast<int16_t>(alu) + static_cast<int16_t>(alub);
+                    extend = (sum < 0) ? 1u : 0u;
+                    alu = static_cast<uint16_t>(sum);
+                } else {
+                    const auto sum = static_cast<uint32_t>(alu) + alub;
+                    extend = sum >> 16u;
+                    alu = static_cast<uint16_t>(sum);
+                }
+                microword = MULM4;
+                DISPATCH();
+            }
+            MICROWORD(MULM5): {
+                // This microword subtracts the multiplicand from the upper half of the product, MULS only
+                // Callers: MULM2, MULM4
+                const auto difference = static_cast<int16_t>(alu) - static_cast<int16_t>(alub);
+                extend = (difference < 0) ? 1u : 0u;
+                alu = static_cast<uint16_t>(difference);
+                microword = MULM4;
+                DISPATCH();
+            }
+            MICROWORD(MULM4): {
+                // This microword shifts the product right one bit and decrements the loop counter,
+                // it tests the counter as it was and the multiplier bits about to be shifted
+                // Callers: MULM2, MULM3, MULM4, MULM5
+                pc = (pc & 0xFFFF'0000u) | atl;
+                const auto counter = au;
+                const auto bits = alue & 3u;
+                au = au - 1u;
+                AluOp_SRAx(extend);
+                extend = Muls ? (alu >> 15u) : 0u; // Without an add or subtract MULS shifts the sign
+                Trace(sink, *this);
+                if (counter == 0u) {
+                    microword = MULM6; // All 16 bits done
+                } else if constexpr (Muls) {
+                    microword = (bits == 1u) ? MULM3 : // 01, add
+                                (bits == 2u) ? MULM5 : // 10, subtract
+                                MULM4;
+                } else {
+                    microword = (bits & 2u) ? MULM3 : MULM4;
+                }
+                DISPATCH();
+            }
+            MICROWORD(MULM6): {
+                // This microword writes the product to rx, sets the flags and starts the next instruction
+                // Callers: MULM4
+                rxdh = alu;
+                rxdl = alue;
+                pc = static_cast<uint32_t>(ath) << 16u | atl;
+                au = pc + 2u;
+                AluOp_AND(alu, 0xFFFFu);
+                SyncFlags();
+                if (alue != 0u) {
+                    flags &= ~FLAG_Z; // Finishing a long result, Z covers the lower half as well
+                }
+                microword = A1;
+                DISPATCH();
+            }
+#if M68K_USE_THREADED_DISPATCH
+            microword_pause: {
+                SyncFlags();
+                return;
+            }
+            microword_exit:
+#else
+            case A1: // control has been returned to next macro instruction
+            default:
+#endif
+            {
+                cycles -= 2u; // Discount these cycles
+                SyncFlags();
+                return;
+            }
+        }
+    }
+}
+
+template auto MC68000::ExecuteMulu(NullTraceSink&) -> void;
+template auto MC68000::ExecuteMulu(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteMulu(RingTraceSink&) -> void;
+template auto MC68000::ExecuteMulu(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteMulu(BinaryTraceSink&) -> void;
+template auto MC68000::ExecuteMuls(NullTraceSink&) -> void;
+template auto MC68000::ExecuteMuls(ConsoleTraceSink&) -> void;
+template auto MC68000::ExecuteMuls(RingTraceSink&) -> void;
+template auto MC68000::ExecuteMuls(ProfileTraceSink&) -> void;
+template auto MC68000::ExecuteMuls(BinaryTraceSink&) -> void;
+
+// The registers are copied into a local that doesn't escape, so once the main loop is inlined
+// they can be kept in machine registers for the whole instruction and are written back once at the exit
+[[gnu::flatten]] auto MC68000::ExecuteMulu() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteMulu(sink);
+    *this = local;
+}
+
+[[gnu::flatten]] auto MC68000::ExecuteMuls() -> void {
+    NullTraceSink sink;
+    auto local = *this;
+    local.ExecuteMuls(sink);
+    *this = local;
+}
@@ -0,0 +1,140 @@
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#include "68000.h"
+#include "68000_Native.h"
+#include "68000_Tables.h"
+
+namespace {
+
+// The flags AluOp_SUB(0, value) leaves, the sign correction of DIVS negates this way
+constexpr auto NegateFlags(uint16_t value) -> uint16_t {
+    MC68000 alu;
+    alu.AluOp_SUB(0u, value);
+    return alu.Flags();
+}
+
+constexpr auto FlagsNZ(uint16_t value) -> uint16_t {
+    return ((value & 0x8000u) ? FLAG_N : 0u) | ((value == 0u) ? FLAG_Z : 0u);
+}
+
+auto PrintState(const char* name, const MC68000& mc68000) -> void {
+    std::fprintf(stderr, "    %-9s rxdh=%04X rxdl=%04X rydl=%04X flags=%02X cycles=%u microword=%s\n", name,
+                 mc68000.rxdh, mc68000.rxdl, mc68000.rydl, mc68000.flags, static_cast<unsigned>(mc68000.cycles),
+                 (mc68000.microword < MICROWORD_COUNT) ? MICROWORD_NAMES[mc68000.microword] : "?");
+}
+
+auto AbortOnMismatch(DivisionInstruction instruction, const MC68000& before, const MC68000& native, const MC68000& microcode) -> void {
+    std::fprintf(stderr, "%s native division disagrees with the microcode\n",
+                 (instruction == DivisionInstruction::Divs) ? "DIVS" : "DIVU");
+    PrintState("before", before);
+    PrintState("native", native);
+    PrintState("microcode", microcode);
+    std::abort();
+}
+
+}
+
+// Mirrors the exits of the microcode, see DivuLanes in 68000_Batch.cpp for the flags
+auto MC68000::ExecuteDivuNative() -> void {
+    const auto dividend = static_cast<uint32_t>(rxdh) << 16u | rxdl;
+    cycles += DivuTableCycles(dividend, rydl);
+    if (rydl == 0u) {
+        flags = FlagsNZ(rxdh) & (FLAG_N | FLAG_Z);
+        microword = TRAP0;
+        return;
+    }
+    microword = A1;
+    if (rxdh >= rydl) {
+        flags = FlagsNZ(rxdh) & FLAG_N;
+        return;
+    }
+    rxdh = static_cast<uint16_t>(dividend % rydl);
+    rxdl = static_cast<uint16_t>(dividend / rydl);
+    flags = FlagsNZ(rxdl);
+}
+
+// Mirrors the exits of the microcode, see DivsLanes in 68000_Batch.cpp for the flags
+auto MC68000::ExecuteDivsNative() -> void {
+    const auto dividend = static_cast<uint32_t>(rxdh) << 16u | rxdl;
+    cycles += DivsTableCycles(dividend, rydl);
+    if (rydl == 0u) {
+        flags = FLAG_Z;
+        microword = TRAP0;
+        return;
+    }
+    microword = A1;
+    const auto negativeDividend = (rxdh & 0x8000u) != 0u;
+    const auto negativeDivisor = (rydl & 0x8000u) != 0u;
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - rydl : rydl);
+    if ((absDividend >> 16u) >= absDivisor) {
+        flags = FlagsNZ(static_cast<uint16_t>(absDividend >> 16u)) & FLAG_N;
+        return;
+    }
+
+    const auto absQuotient = static_cast<uint16_t>(absDividend / absDivisor);
+    const auto absRemainder = static_cast<uint16_t>(absDividend % absDivisor);
+    const auto negatedQuotient = static_cast<uint16_t>(0u - absQuotient);
+    const auto negatedQuotientFlags = NegateFlags(absQuotient);
+    const auto negatedRemainderFlags = NegateFlags(absRemainder);
+    const auto lateOverflow = (negativeDivisor != negativeDividend) ?
+                              (negatedQuotientFlags & (FLAG_N | FLAG_Z)) == 0u :
+                              (absQuotient & 0x8000u) != 0u;
+    const auto quotient = (negativeDivisor != negativeDividend) ? negatedQuotient : absQuotient;
+    if (negativeDividend) {
+        flags = lateOverflow ? negatedRemainderFlags : (negatedRemainderFlags & FLAG_X) | FlagsNZ(quotient);
+    } else if (negativeDivisor) {
+        flags = (negatedQuotientFlags & FLAG_X) | FlagsNZ(negatedQuotient);
+    } else {
+        // X is the borrow of the last quotient bit
+        flags = ((absQuotient & 1u) ? 0u : FLAG_X) | FlagsNZ(absQuotient);
+    }
+    if (!lateOverflow) {
+        rxdh = negativeDividend ? static_cast<uint16_t>(0u - absRemainder) : absRemainder;
+        rxdl = quotient;
+    }
+}
+
+DualModeDivision::DualModeDivision(DivisionMode mode, uint32_t sampleInterval) :
+    mode(mode),
+    sampleInterval(sampleInterval),
+    untilSample(sampleInterval),
+    mismatchHandler(AbortOnMismatch) {}
+
+auto DualModeDivision::SetSampleInterval(uint32_t value) -> void {
+    sampleInterval = value;
+    untilSample = value;
+}
+
+auto DualModeDivision::SetMismatchHandler(MismatchHandler handler) -> void {
+    mismatchHandler = handler ? std::move(handler) : MismatchHandler(AbortOnMismatch);
+}
+
+auto DualModeDivision::Execute(DivisionInstruction instruction, MC68000& mc68000) -> void {
+    if (mode == DivisionMode::Microcode) {
+        (instruction == DivisionInstruction::Divs) ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+        return;
+    }
+    ++statistics.native;
+    if (sampleInterval == 0u || --untilSample != 0u) {
+        (instruction == DivisionInstruction::Divs) ? mc68000.ExecuteDivsNative() : mc68000.ExecuteDivuNative();
+        return;
+    }
+    untilSample = sampleInterval;
+    const auto before = mc68000;
+    (instruction == DivisionInstruction::Divs) ? mc68000.ExecuteDivsNative() : mc68000.ExecuteDivuNative();
+    Verify(instruction, before, mc68000);
+}
+
+auto DualModeDivision::Verify(DivisionInstruction instruction, const MC68000& before, const MC68000& native) -> void {
+    auto microcode = before;
+    (instruction == DivisionInstruction::Divs) ? microcode.ExecuteDivs() : microcode.ExecuteDivu();
+    ++statistics.verified;
+    if (native.rxdh != microcode.rxdh || native.rxdl != microcode.rxdl || native.rydl != microcode.rydl ||
+        native.flags != microcode.flags || native.cycles != microcode.cycles || native.microword != microcode.microword) {
+        ++statistics.mismatches;
+        mismatchHandler(instruction, before, native, microcode);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "68000.h"
+#include "68000_Batch.h"
+
+// Divisions at native speed with sampled verification against the microcode.
+//
+// In Native mode DIVU and DIVS run as a 32/16 hardware division with the cycles taken from the generated
+// tables (MC68000::ExecuteDivuNative/ExecuteDivsNative). One in every sampleInterval native divisions is
+// also run through the microcode from the same starting state and the results are compared:
+// rxdh, rxdl, rydl, flags, cycles and the exit microword. Microcode mode always runs the microcode.
+//
+// The sample counter isn't shared, use one DualModeDivision per thread.
+
+enum class DivisionMode {
+    Microcode,
+    Native,
+};
+
+struct ShadowStatistics {
+    uint64_t native; // Divisions run natively
+    uint64_t verified; // Native divisions also run through the microcode
+    uint64_t mismatches;
+};
+
+class DualModeDivision {
+public:
+    // Receives the state before the division and the states left by both paths.
+    // The default handler prints them and aborts
+    using MismatchHandler = std::function<void(DivisionInstruction, const MC68000& before, const MC68000& native,
+                                               const MC68000& microcode)>;
+
+    // A sampleInterval of 0 never verifies, 1 verifies every division
+    explicit DualModeDivision(DivisionMode mode = DivisionMode::Native, uint32_t sampleInterval = 1024u);
+
+    auto Divu(MC68000& mc68000) -> void { Execute(DivisionInstruction::Divu, mc68000); }
+    auto Divs(MC68000& mc68000) -> void { Execute(DivisionInstruction::Divs, mc68000); }
+    auto Execute(DivisionInstruction, MC68000&) -> void;
+
+    auto Mode() const -> DivisionMode { return mode; }
+    auto SetMode(DivisionMode value) -> void { mode = value; }
+    auto SampleInterval() const -> uint32_t { return sampleInterval; }
+    // Restarts the count, so the next native division is verified after sampleInterval - 1 that aren't
+    auto SetSampleInterval(uint32_t) -> void;
+    auto SetMismatchHandler(MismatchHandler) -> void;
+
+    auto Statistics() const -> const ShadowStatistics& { return statistics; }
+
+private:
+    auto Verify(DivisionInstruction, const MC68000& before, const MC68000& native) -> void;
+
+    DivisionMode mode;
+    uint32_t sampleInterval;
+    uint32_t untilSample; // Native divisions before the next verified one
+    MismatchHandler mismatchHandler;
+    ShadowStatistics statistics{};
+};
@@ -0,0 +1,101 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "68000.h"
+#include "68000_Pool.h"
+
+auto MC68000Pool::Resize(std::size_t size) -> void {
+    microword.resize(size, static_cast<uint16_t>(A1)); // DVUR1 is 0, a zeroed context would run
+    rxdh.resize(size);
+    rxdl.resize(size);
+    rydl.resize(size);
+    pc.resize(size);
+    alue.resize(size);
+    alub.resize(size);
+    alu.resize(size);
+    flags.resize(size);
+    au.resize(size);
+    ath.resize(size);
+    atl.resize(size);
+    cycles.resize(size);
+    instruction.resize(size, DivisionInstruction::Divu);
+}
+
+auto MC68000Pool::Load(std::size_t i) const -> MC68000 {
+    MC68000 mc68000;
+    mc68000.microword = microword[i];
+    mc68000.rxdh = rxdh[i];
+    mc68000.rxdl = rxdl[i];
+    mc68000.rydl = rydl[i];
+    mc68000.pc = pc[i];
+    mc68000.alue = alue[i];
+    mc68000.alub = alub[i];
+    mc68000.alu = alu[i];
+    mc68000.flags = flags[i];
+    mc68000.au = au[i];
+    mc68000.ath = ath[i];
+    mc68000.atl = atl[i];
+    mc68000.cycles = cycles[i];
+    return mc68000;
+}
+
+auto MC68000Pool::Store(std::size_t i, const MC68000& mc68000) -> void {
+    microword[i] = mc68000.microword;
+    rxdh[i] = mc68000.rxdh;
+    rxdl[i] = mc68000.rxdl;
+    rydl[i] = mc68000.rydl;
+    pc[i] = mc68000.pc;
+    alue[i] = mc68000.alue;
+    alub[i] = mc68000.alub;
+    alu[i] = mc68000.alu;
+    flags[i] = mc68000.flags;
+    au[i] = mc68000.au;
+    ath[i] = mc68000.ath;
+    atl[i] = mc68000.atl;
+    cycles[i] = mc68000.cycles;
+}
+
+auto MC68000Pool::SetDivu(std::size_t i, uint32_t dividend, uint16_t divisor) -> void {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.microword = DVUR1;
+    Store(i, mc68000);
+    instruction[i] = DivisionInstruction::Divu;
+}
+
+auto MC68000Pool::SetDivs(std::size_t i, uint32_t dividend, uint16_t divisor) -> void {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.microword = DVS01;
+    Store(i, mc68000);
+    instruction[i] = DivisionInstruction::Divs;
+}
+
+auto MC68000Pool::Execute() -> void {
+    Execute(0u, Size());
+}
+
+auto MC68000Pool::Execute(std::size_t first, std::size_t count) -> void {
+    if (first > Size() || count > Size() - first) {
+        throw std::invalid_argument("Pool contexts past the end");
+    }
+    for (auto i = first; i < first + count; ++i) {
+        if (microword[i] == TRAP0 || microword[i] == A1) {
+            continue;
+        }
+        auto mc68000 = Load(i);
+        // A resumed context has no cycle budget, it runs to the exit
+        const auto unlimited = UINT32_MAX - mc68000.cycles;
+        if (instruction[i] == DivisionInstruction::Divs) {
+            if (microword[i] == DVS01) {
+                mc68000.ExecuteDivs();
+            } else {
+                mc68000.RunDivs(unlimited);
+            }
+        } else if (microword[i] == DVUR1) {
+            mc68000.ExecuteDivu();
+        } else {
+            mc68000.RunDivu(unlimited);
+        }
+        Store(i, mc68000);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Batch.h"
+
+// Many division contexts in structure-of-arrays form, one array per MC68000 register.
+//
+// Execute advances every context from its microword until it leaves the division microcode at TRAP0 or A1.
+// Each context is loaded into a local MC68000 once, run with its registers held in locals, and stored once.
+// A context stored part way through an instruction, say after RunDivu or RunDivs ran out of cycles, resumes
+// from its microword with its internal registers, instruction telling DIVU from DIVS in the microwords they share.
+// The arrays aren't advanced in lock-step, the vector engines of 68000_Batch.h don't keep the internal registers.
+// For the results of many divisions at once use ExecuteDivuBatch and ExecuteDivsBatch.
+
+struct MC68000Pool {
+    std::vector<uint16_t> microword;
+    std::vector<uint16_t> rxdh;
+    std::vector<uint16_t> rxdl;
+    std::vector<uint16_t> rydl;
+    std::vector<uint32_t> pc;
+    std::vector<uint16_t> alue;
+    std::vector<uint16_t> alub;
+    std::vector<uint16_t> alu;
+    std::vector<uint16_t> flags;
+    std::vector<uint32_t> au;
+    std::vector<uint16_t> ath;
+    std::vector<uint16_t> atl;
+    std::vector<uint32_t> cycles;
+    std::vector<DivisionInstruction> instruction; // Set by SetDivu and SetDivs, Store leaves it
+
+    MC68000Pool() = default;
+    explicit MC68000Pool(std::size_t size) { Resize(size); }
+
+    auto Size() const -> std::size_t { return microword.size(); }
+
+    // New contexts are zeroed, like a default MC68000, but at A1 so they don't run until SetDivu or SetDivs
+    auto Resize(std::size_t) -> void;
+
+    auto Load(std::size_t) const -> MC68000;
+    auto Store(std::size_t, const MC68000&) -> void;
+
+    // Reset a context to run a division with the dividend in rxdh:rxdl and the divisor in rydl
+    auto SetDivu(std::size_t, uint32_t dividend, uint16_t divisor) -> void;
+    auto SetDivs(std::size_t, uint32_t dividend, uint16_t divisor) -> void;
+
+    // Contexts at TRAP0 or A1 are left as they are.
+    // Throws std::invalid_argument when first + count is past Size()
+    auto Execute() -> void;
+    auto Execute(std::size_t first, std::size_t count) -> void;
+};
@@ -0,0 +1,43 @@
+#include <ostream>
+
+#include "68000.h"
+#include "68000_Profile.h"
+
+auto ProfileTraceSink::WriteCsv(std::ostream& out) const -> void {
+    out << "kind,from,to,count\n";
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        if (executions[i] != 0u) {
+            out << "microword," << MICROWORD_NAMES[i] << ",," << executions[i] << '\n';
+        }
+    }
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        for (auto j = 0u; j < MICROWORD_COUNT; ++j) {
+            if (branches[i][j] != 0u) {
+                out << "branch," << MICROWORD_NAMES[i] << ',' << MICROWORD_NAMES[j] << ',' << branches[i][j] << '\n';
+            }
+        }
+    }
+}
+
+auto ProfileTraceSink::WriteJson(std::ostream& out) const -> void {
+    out << "{\"microwords\":{";
+    auto separator = "";
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        if (executions[i] != 0u) {
+            out << separator << '"' << MICROWORD_NAMES[i] << "\":" << executions[i];
+            separator = ",";
+        }
+    }
+    out << "},\"branches\":[";
+    separator = "";
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        for (auto j = 0u; j < MICROWORD_COUNT; ++j) {
+            if (branches[i][j] != 0u) {
+                out << separator << "{\"from\":\"" << MICROWORD_NAMES[i] << "\",\"to\":\"" << MICROWORD_NAMES[j]
+                    << "\",\"count\":" << branches[i][j] << '}';
+                separator = ",";
+            }
+        }
+    }
+    out << "]}\n";
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+#include "68000.h"
+
+// Counts how often each microword runs and how often each branch between two microwords is taken,
+// for example DVUMB to DVUME against DVUMB to DVUM6.
+// Entering TRAP0 or A1 is counted as running it, so the counts of the exits are the number of divisions.
+//
+// Use one sink per thread and add them together afterwards
+//     ProfileTraceSink total;
+//     for (const auto& sink : perThread) { total += sink; }
+
+struct ProfileTraceSink {
+    std::array<uint64_t, MICROWORD_COUNT> executions{};
+    std::array<std::array<uint64_t, MICROWORD_COUNT>, MICROWORD_COUNT> branches{}; // [from][to]
+
+    auto Step(uint16_t previous, uint16_t next) -> void {
+        ++executions[next];
+        if (previous < MICROWORD_COUNT) {
+            ++branches[previous][next];
+        }
+    }
+
+    auto operator+=(const ProfileTraceSink& other) -> ProfileTraceSink& {
+        for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+            executions[i] += other.executions[i];
+            for (auto j = 0u; j < MICROWORD_COUNT; ++j) {
+                branches[i][j] += other.branches[i][j];
+            }
+        }
+        return *this;
+    }
+
+    auto Clear() -> void {
+        executions = {};
+        branches = {};
+    }
+
+    // Only the microwords and branches seen are written
+    //     kind,from,to,count
+    //     microword,DVUMB,,15
+    //     branch,DVUMB,DVUME,9
+    auto WriteCsv(std::ostream&) const -> void;
+
+    //     {"microwords":{"DVUMB":15},"branches":[{"from":"DVUMB","to":"DVUME","count":9}]}
+    auto WriteJson(std::ostream&) const -> void;
+};
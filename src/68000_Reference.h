@@ -0,0 +1,195 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+
+// Reference models for the division instructions, independent of the microcode
+
+/*
+ * Unsigned division
+ */
+struct DivuResult {
+    uint16_t remainder;
+    uint16_t quotient;
+};
+
+constexpr auto DivideUnsigned(uint32_t dividend, uint16_t divisor) -> DivuResult {
+    const DivuResult failure = {
+        static_cast<uint16_t>(dividend >> 16u),
+        static_cast<uint16_t>(dividend)
+    };
+    if (divisor == 0u) {
+        return failure;
+    }
+    const auto quotient = dividend / divisor;
+    const auto remainder = dividend % divisor;
+    if (quotient >= 0x1'0000u) {
+        return failure;
+    }
+    return { static_cast<uint16_t>(remainder), static_cast<uint16_t>(quotient) };
+}
+
+constexpr auto DivideUnsignedCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    auto cycles = 2u * 2u; // DVUR1, DVUM2
+
+    if (divisor == 0u) {
+        // The core only, InstructionCycles in 68000_Timing.h adds the exception timing
+        return 0u;
+    }
+
+    cycles += 1u * 2u; // DVUM3
+
+    if (dividend / divisor >= 0x1'0000u) {
+        cycles += 2u * 2u; // DVUM4, DVUMA
+        return cycles;
+    }
+
+    const auto alignedDivisor = uint32_t{ divisor } << 16u;
+    for (auto i = 0u; i < 15u; ++i) {
+        cycles += 2u * 2u; // DVUM5/6 DVUM7/8
+        const auto previous = dividend;
+        dividend <<= 1u;
+        if (previous & 0x8000'0000u) {
+            dividend -= alignedDivisor;
+        } else if (dividend >= alignedDivisor) {
+            cycles += 1u * 2u; // DVUMB
+            dividend -= alignedDivisor;
+        } else {
+            cycles += 2u * 2u; // DVUMB DVUME
+        }
+    }
+
+    cycles += 4u * 2u; // DVUM5/6 DVUM7/8 DVUM9/C DVUMD/F
+    cycles += 1u * 2u; // DVUM0
+
+    return cycles;
+}
+
+/*
+ * Signed division
+ */
+constexpr auto SignBit(auto v) -> bool {
+    const auto msb = sizeof(v) * CHAR_BIT - 1u;
+    const auto mask = 1u << msb;
+    return v & mask;
+}
+
+constexpr auto SameSignBit(uint32_t dividend, uint16_t divisor) -> bool {
+    return !(SignBit(dividend) ^ SignBit(divisor));
+}
+
+constexpr auto AbsoluteValue(auto v) -> decltype(v) {
+    return SignBit(v) ? -v : v;
+}
+
+struct DivsResult {
+    uint16_t remainder;
+    uint16_t quotient;
+};
+
+constexpr auto DivideSigned(uint32_t dividend, uint16_t divisor) -> DivsResult {
+    const DivsResult failure = {
+        static_cast<uint16_t>(dividend >> 16u),
+        static_cast<uint16_t>(dividend)
+    };
+    if (divisor == 0u) {
+        return failure;
+    }
+    const auto absDividend = AbsoluteValue(dividend);
+    const auto absDivisor = AbsoluteValue(divisor);
+    const auto absQuotient = absDividend / absDivisor;
+    const auto absRemainder = absDividend % absDivisor;
+    if (absQuotient >= 0x1'0000u) {
+        return failure;
+    }
+    // remainder same sign as dividend
+    const uint16_t remainder = SignBit(dividend) ? -absRemainder : absRemainder;
+    const uint16_t quotient = SameSignBit(dividend, divisor) ? absQuotient : -absQuotient;
+    if (SameSignBit(dividend, divisor)) {
+        // quotient should be greater than equal to zero
+        if (SignBit(quotient)) {
+            return failure;
+        }
+    } else if (!SignBit(quotient) && (quotient != 0u)) {
+        // quotient should be less than or equal to zero
+        return failure;
+    }
+    return { remainder, quotient };
+}
+
+constexpr auto DivideSignedCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    auto cycles = 2u * 2u; // DVS01, DVS03
+
+    if (divisor == 0u) {
+        // The core only, InstructionCycles in 68000_Timing.h adds the exception timing
+        return 0u;
+    }
+
+    if (SignBit(dividend)) {
+        cycles += 5u * 2u; // DVS04/5, DVS06, DVS10, DVS11, DVS08
+    } else {
+        cycles += 4u * 2u; // DVS04/5, DVS06, DVS07, DVS08,
+    }
+
+    auto absDividend = AbsoluteValue(dividend);
+    auto absDivisor = AbsoluteValue(divisor);
+
+    if (absDividend / absDivisor >= 0x1'0000u) {
+        cycles += 2u * 2u; // DVUMZ, DVUMA
+        return cycles;
+    }
+
+    const auto alignedDivisor = uint32_t{ absDivisor } << 16u;
+    for (auto i = 0u; i < 15u; ++i) {
+        cycles += 3u * 2u; // DVS09/A DVS0C, DVS0D
+        absDividend <<= 1u;
+        if (absDividend >= alignedDivisor) {
+            absDividend -= alignedDivisor;
+        } else {
+            cycles += 2u; // DVS0F
+        }
+    }
+    cycles += 5u * 2u; // DVS09/A, DVS0C, DVS0E, DVS12/13, DVS14
+
+    if (SignBit(divisor)) {
+        // DVS15, DVS1D, DVS1F, DVS20
+        // DVS15, DVS1D, DVS1E, DVS1C
+        // DVS15, DVS1D, DVS1E, DVUM4
+        cycles += 4u * 2u;
+    } else if (SignBit(dividend)) {
+        // DVS15, DVS16, DVS1A, DVS1B, DVS1C
+        // DVS15, DVS16, DVS1A, DVS1B, DVUM4
+        cycles += 5u * 2u;
+    } else {
+        // DVS15, DVS16, DVS17
+        cycles += 3u * 2u;
+    }
+    cycles += 1u * 2u; // LEAA2 or DVUMA
+
+    return cycles;
+}
+
+/*
+ * Overflow and flags
+ */
+constexpr auto DivideUnsignedOverflows(uint32_t dividend, uint16_t divisor) -> bool {
+    return divisor == 0u || dividend / divisor >= 0x1'0000u;
+}
+
+constexpr auto DivideSignedOverflows(uint32_t dividend, uint16_t divisor) -> bool {
+    if (divisor == 0u) {
+        return true;
+    }
+    const auto absQuotient = AbsoluteValue(dividend) / AbsoluteValue(divisor);
+    if (SameSignBit(dividend, divisor)) {
+        return absQuotient > 0x7FFFu;
+    }
+    return absQuotient > 0x8000u;
+}
+
+// N and Z (0x08, 0x04) of the quotient, V and C (0x02, 0x01) clear.
+// Only defined when the division doesn't overflow, the emulator doesn't model the V flag or the
+// trap, and X isn't affected by the instruction
+constexpr auto DivideFlags(uint16_t quotient) -> uint16_t {
+    return ((quotient & 0x8000u) ? 0x08u : 0u) | ((quotient == 0u) ? 0x04u : 0u);
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+
+#include "68000.h"
+
+// Microcode ROM for the division microwords, generated at build time from the Appendix F listing
+// by 68000_Division_RomGen and executed by MC68000::ExecuteRom.
+// The ROM and its interpreter are constexpr, so divisions can be run by the compiler.
+//
+// Each microword of the listing names the nanoword it uses (the third field of its box),
+// microwords sharing a nanoword share its operation, such as DVUM7/DVUM8/DVS0C or DVUM3/DVS04.
+// The next address and branch condition come from the arrows below each box.
+
+// Register transfers and ALU operation of a nanoword, named after the microword it originates from
+enum class Nanoword : uint8_t {
+    DVUR1, // pc = au, alue = rxdl, alub = ath = rydl, alu = rydl AND 0xFFFF
+    DVUM2, // alu = rxdh - alub
+    DVUM3, // au = 16, atl = rxdh, alu = rxdh AND 0xFFFF
+    DVUM5, // au - 1, shift a 0 into alu:alue
+    DVUM6, // au - 1, shift a 1 into alu:alue
+    DVUM7, // atl = alu, alu = alu - alub
+    DVUM9, // rxdh = alu, alu = alu AND 0
+    DVUMA, // Nothing
+    DVUMB, // Nothing
+    DVUMD, // au = pc + 2, alub = alu, shift a 1 into alu:alue
+    DVUME, // alu = atl AND 0xFFFF
+    DVUMF, // au = pc + 2, alub = alu, rxdh = atl, shift a 0 into alu:alue
+    DVUM0, // rxdl = alue, alu = alue - alub
+    MMRW2, // Nothing
+    DVS03, // alu = 0 - alub
+    DVS05, // au = 16, atl = rxdh, alub = alu, alu = rxdh AND 0xFFFF
+    DVS06, // alu = 0 - rxdl
+    DVS07, // alu = atl - alub
+    DVS10, // alue = alu, alu = 0 - rxdh - x
+    DVS11, // atl = alu, alu = atl - alub
+    DVS12, // Shift a 0 into alu:alue, see below
+    DVS13, // atl = alu, shift a 1 into alu:alue
+    DVS14, // alu = ath AND 0xFFFF
+    DVS15, // alub = alue, alu = rxdh AND 0xFFFF
+    DVS16, // ath = atl, alu = alub AND 0xFFFF
+    DVS17, // atl = alu, alu = alub AND 0xFFFF
+    DVS1B, // alub = atl = alu, alu = 0 - ath
+    DVS1C, // ath = alu, alu = alub AND 0xFFFF
+    DVS20, // atl = alub = alu, alu = alub AND 0xFFFF, see below
+    LEAA2, // rxdh = ath, rxdl = atl
+    Exit, // TRAP0, A1 and the microwords outside the division microcode, control leaves the ROM
+};
+
+// The listing has DVS12 sharing the nanoword of DVUM5 and DVS20 sharing that of DVS17.
+// The emulator doesn't decrement the expired loop counter in DVS12 and also updates alub in DVS20,
+// these keep their own operations so the ROM produces exactly the state of ExecuteDivu/ExecuteDivs.
+
+// Branch conditions, tested on the flags before the operation and on au after it
+enum class Condition : uint8_t {
+    Always, // next[0]
+    C, // next[0] if C, otherwise next[1]
+    N, // next[0] if N, otherwise next[1]
+    Z, // next[0] if Z, otherwise next[1]
+    NOrZ, // next[0] if N or Z, otherwise next[1]
+    AuZero, // next[0] if au is 0, otherwise next[1]
+    ZThenN, // next[0] if Z, next[1] if N, otherwise next[2]
+};
+
+struct RomEntry {
+    Nanoword nanoword;
+    Condition condition;
+    uint8_t next[3];
+};
+
+// Defines MICROCODE_ROM, indexed by microword label
+#include "68000_MicrocodeRom.h"
+
+// Index into RomEntry::next of the successor
+constexpr auto SelectNext(Condition condition, uint16_t flags, uint32_t au) -> uint32_t {
+    switch (condition) {
+        case Condition::Always: return 0u;
+        case Condition::C: return (flags & FLAG_C) ? 0u : 1u;
+        case Condition::N: return (flags & FLAG_N) ? 0u : 1u;
+        case Condition::Z: return (flags & FLAG_Z) ? 0u : 1u;
+        case Condition::NOrZ: return (flags & (FLAG_N | FLAG_Z)) ? 0u : 1u;
+        case Condition::AuZero: return (au == 0u) ? 0u : 1u;
+        case Condition::ZThenN: return (flags & FLAG_Z) ? 0u : (flags & FLAG_N) ? 1u : 2u;
+    }
+    return 0u;
+}
+
+constexpr auto MC68000::ExecuteRom(uint16_t entry) -> void {
+    microword = entry;
+    while (true) {
+        const auto& rom = MICROCODE_ROM[microword];
+        const auto oldFlags = Flags();
+        switch (rom.nanoword) {
+            case Nanoword::DVUR1:
+                pc = au;
+                alue = rxdl;
+                alub = rydl;
+                ath = rydl;
+                AluOp_AND(rydl, 0xFFFFu);
+                break;
+            case Nanoword::DVUM2:
+                AluOp_SUB(rxdh, alub);
+                break;
+            case Nanoword::DVUM3:
+                au = 15u + 1u;
+                atl = rxdh;
+                AluOp_AND(rxdh, 0xFFFFu);
+                break;
+            case Nanoword::DVUM5:
+                au = au - 1u;
+                AluOp_SLAAx(0u);
+                break;
+            case Nanoword::DVUM6:
+                au = au - 1u;
+                AluOp_SLAAx(1u);
+                break;
+            case Nanoword::DVUM7:
+                atl = alu;
+                AluOp_SUB(alu, alub);
+                break;
+            case Nanoword::DVUM9:
+                rxdh = alu;
+                AluOp_AND(alu, 0u);
+                break;
+            case Nanoword::DVUMA:
+            case Nanoword::DVUMB:
+            case Nanoword::MMRW2:
+                break;
+            case Nanoword::DVUMD:
+                au = pc + 2u;
+                alub = alu;
+                AluOp_SLAAx(1u);
+                break;
+            case Nanoword::DVUME:
+                AluOp_AND(atl, 0xFFFFu);
+                break;
+            case Nanoword::DVUMF:
+                au = pc + 2u;
+                alub = alu;
+                rxdh = atl;
+                AluOp_SLAAx(0u);
+                break;
+            case Nanoword::DVUM0:
+                rxdl = alue;
+                AluOp_SUB(alue, alub);
+                break;
+            case Nanoword::DVS03:
+                AluOp_SUB(0u, alub);
+                break;
+            case Nanoword::DVS05:
+                au = 15u + 1u;
+                atl = rxdh;
+                alub = alu;
+                AluOp_AND(rxdh, 0xFFFFu);
+                break;
+            case Nanoword::DVS06:
+                AluOp_SUB(0u, rxdl);
+                break;
+            case Nanoword::DVS07:
+                AluOp_SUB(atl, alub);
+                break;
+            case Nanoword::DVS10:
+                alue = alu;
+                AluOp_SUBX(0u, rxdh);
+                break;
+            case Nanoword::DVS11:
+                atl = alu;
+                AluOp_SUB(atl, alub);
+                break;
+            case Nanoword::DVS12:
+                AluOp_SLAAx(0u);
+                break;
+            case Nanoword::DVS13:
+                atl = alu;
+                AluOp_SLAAx(1u);
+                break;
+            case Nanoword::DVS14:
+                AluOp_AND(ath, 0xFFFFu);
+                break;
+            case Nanoword::DVS15:
+                alub = alue;
+                AluOp_AND(rxdh, 0xFFFFu);
+                break;
+            case Nanoword::DVS16:
+                ath = atl;
+                AluOp_AND(alub, 0xFFFFu);
+                break;
+            case Nanoword::DVS17:
+                atl = alu;
+                AluOp_AND(alub, 0xFFFFu);
+                break;
+            case Nanoword::DVS1B:
+                alub = alu;
+                atl = alu;
+                AluOp_SUB(0u, ath);
+                break;
+            case Nanoword::DVS1C:
+                ath = alu;
+                AluOp_AND(alub, 0xFFFFu);
+                break;
+            case Nanoword::DVS20:
+                atl = alu;
+                alub = alu;
+                AluOp_AND(alub, 0xFFFFu);
+                break;
+            case Nanoword::LEAA2:
+                rxdh = ath;
+                rxdl = atl;
+                break;
+            case Nanoword::Exit:
+                SyncFlags();
+                return;
+        }
+        cycles += 2u;
+        microword = rom.next[SelectNext(rom.condition, oldFlags, au)];
+    }
+}
+
+// State of the processor after the microcode of a division, tracing disabled
+constexpr auto RomDivu(uint32_t dividend, uint16_t divisor) -> MC68000 {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteRom(DVUR1);
+    return mc68000;
+}
+
+constexpr auto RomDivs(uint32_t dividend, uint16_t divisor) -> MC68000 {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteRom(DVS01);
+    return mc68000;
+}
+
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "68000.h"
+
+// Generates the constexpr definition of MICROCODE_ROM (68000_Rom.h) from the Appendix F microcode listing.
+//
+// Every microword is drawn as a box whose bottom line holds its address, its label and the label of the
+// nanoword it uses
+//     |      2db  |   dvum7    |   dvum7   |
+// Its successors are drawn below the box in the same column, either as an arrow to a label or the next box
+//     v
+//     dvum2
+// or as branches
+//     |--->  dvum6  if au/=0
+//     |--->  dvum9  if au=0
+// Microwords that return to the next instruction have a1 in the right column of the box instead.
+
+namespace {
+
+struct Label {
+    const char* name;
+    uint32_t value;
+};
+
+constexpr auto LABELS = std::to_array<Label>({
+    {"dvur1", DVUR1}, {"dvum2", DVUM2}, {"dvum3", DVUM3}, {"dvum4", DVUM4},
+    {"dvum5", DVUM5}, {"dvum6", DVUM6}, {"dvum7", DVUM7}, {"dvum8", DVUM8},
+    {"dvum9", DVUM9}, {"dvuma", DVUMA}, {"dvumb", DVUMB}, {"dvumc", DVUMC},
+    {"dvumd", DVUMD}, {"dvume", DVUME}, {"dvumf", DVUMF}, {"dvum0", DVUM0},
+    {"dvumz", DVUMZ}, {"dvs01", DVS01}, {"dvs03", DVS03}, {"dvs04", DVS04},
+    {"dvs05", DVS05}, {"dvs06", DVS06}, {"dvs07", DVS07}, {"dvs08", DVS08},
+    {"dvs09", DVS09}, {"dvs0a", DVS0A}, {"dvs0c", DVS0C}, {"dvs0d", DVS0D},
+    {"dvs0e", DVS0E}, {"dvs0f", DVS0F}, {"dvs10", DVS10}, {"dvs11", DVS11},
+    {"dvs12", DVS12}, {"dvs13", DVS13}, {"dvs14", DVS14}, {"dvs15", DVS15},
+    {"dvs16", DVS16}, {"dvs17", DVS17}, {"dvs1a", DVS1A}, {"dvs1b", DVS1B},
+    {"dvs1c", DVS1C}, {"dvs1d", DVS1D}, {"dvs1e", DVS1E}, {"dvs1f", DVS1F},
+    {"dvs20", DVS20}, {"leaa2", LEAA2}, {"trap0", TRAP0}, {"a1", A1},
+});
+
+// Where the emulator departs from the shared nanoword of the listing, see 68000_Rom.h
+const std::map<std::string, std::string> NANOWORD_OVERRIDES = {
+    {"dvs12", "DVS12"},
+    {"dvs20", "DVS20"},
+};
+
+// Successors the listing doesn't show, the arrow below dvs13 runs off the page
+const std::map<std::string, std::string> SUCCESSOR_OVERRIDES = {
+    {"dvs13", "dvs14"},
+};
+
+// Condition and the order of the targets in RomEntry::next for each set of branch conditions
+struct ConditionForm {
+    const char* condition;
+    std::vector<std::string> order;
+};
+
+const std::vector<ConditionForm> CONDITION_FORMS = {
+    {"C", {"c", "/c"}},
+    {"N", {"n", "/n"}},
+    {"Z", {"x", "/x"}}, // DVUM2 tests for a zero divisor through x, the emulator takes it from Z
+    {"NOrZ", {"n+z", "/n /z"}},
+    {"AuZero", {"au=0", "au/=0"}},
+    {"ZThenN", {"z", "/z*n", "/z*/n"}},
+};
+
+constexpr auto COLUMN_WIDTH = 40u;
+
+struct Box {
+    std::size_t line; // Line of the address/label/nanoword
+    std::size_t column;
+    std::string address;
+    std::string label;
+    std::string nanoword;
+};
+
+struct Branch {
+    std::string target;
+    std::string condition; // Empty for an unconditional successor
+};
+
+auto Trim(const std::string& s) -> std::string {
+    const auto first = s.find_first_not_of(' ');
+    if (first == std::string::npos) {
+        return {};
+    }
+    return s.substr(first, s.find_last_not_of(' ') - first + 1u);
+}
+
+auto Column(const std::string& line, std::size_t column) -> std::string {
+    return (line.size() > column) ? line.substr(column, COLUMN_WIDTH) : std::string{};
+}
+
+auto IsLabel(const std::string& s) -> bool {
+    return std::ranges::any_of(LABELS, [&](const Label& label) { return s == label.name; });
+}
+
+auto LabelValue(const std::string& s) -> uint32_t {
+    return std::ranges::find_if(LABELS, [&](const Label& label) { return s == label.name; })->value;
+}
+
+auto Upper(std::string s) -> std::string {
+    std::ranges::transform(s, s.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return s;
+}
+
+auto FindBoxes(const std::vector<std::string>& lines) -> std::vector<Box> {
+    const std::regex bottom(R"(\|\s+([0-9a-f]+)\s+\|\s+(\w+)\s+\|\s+(\w+)\s+\|)");
+    std::vector<Box> boxes;
+    for (auto i = 0u; i < lines.size(); ++i) {
+        for (auto it = std::sregex_iterator(lines[i].begin(), lines[i].end(), bottom); it != std::sregex_iterator(); ++it) {
+            boxes.push_back({i, static_cast<std::size_t>(it->position()), (*it)[1], (*it)[2], (*it)[3]});
+        }
+    }
+    return boxes;
+}
+
+// The next box drawn below in the same column
+auto BoxBelow(const std::vector<Box>& boxes, const Box& box) -> std::optional<std::string> {
+    for (const auto& other : boxes) {
+        if (other.column == box.column && other.line > box.line) {
+            return other.label;
+        }
+    }
+    return std::nullopt;
+}
+
+// Whether the right column of the box holds a1, the return to the next instruction
+auto ReturnsToA1(const std::vector<std::string>& lines, const Box& box) -> bool {
+    for (auto i = box.line; i-- > 0u;) {
+        const auto column = Column(lines[i], box.column);
+        if (column.empty() || column[0] != '|') {
+            break;
+        }
+        const auto second = column.find('|', 1u);
+        const auto third = (second == std::string::npos) ? second : column.find('|', second + 1u);
+        if (third != std::string::npos && Trim(column.substr(second + 1u, third - second - 1u)) == "a1") {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto Successors(const std::vector<std::string>& lines, const std::vector<Box>& boxes, const Box& box) -> std::vector<Branch> {
+    if (SUCCESSOR_OVERRIDES.contains(box.label)) {
+        return {{SUCCESSOR_OVERRIDES.at(box.label), {}}};
+    }
+
+    const std::regex branch(R"(\|--->\s+(\w+)(?:\s+if\s+(.+))?)");
+    std::vector<Branch> branches;
+    auto arrow = false;
+    // Skip the line closing the box
+    for (auto i = box.line + 2u; i < lines.size() && lines[i].find("####") == std::string::npos; ++i) {
+        const auto column = Column(lines[i], box.column);
+        const auto text = Trim(column);
+        std::smatch match;
+        if (std::regex_search(text, match, branch)) {
+            branches.push_back({match[1], Trim(match[2])});
+            continue;
+        }
+        if (!branches.empty()) {
+            if (text == "|") {
+                continue; // Connector to the next branch
+            }
+            break;
+        }
+        if (column.find("____") != std::string::npos) {
+            if (const auto below = BoxBelow(boxes, box); arrow && below) {
+                branches.push_back({*below, {}});
+            }
+            break;
+        }
+        if (text == "v") {
+            arrow = true;
+            continue;
+        }
+        // Either a label the arrow points to or one annotated on the line leaving the box
+        const auto word = Trim((!text.empty() && text[0] == '|') ? text.substr(1u) : text);
+        if (IsLabel(word)) {
+            branches.push_back({word, {}});
+            break;
+        }
+        if (!text.empty() && text != "|") {
+            break; // Connector to another sheet
+        }
+    }
+
+    if (branches.empty() && ReturnsToA1(lines, box)) {
+        branches.push_back({"a1", {}});
+    }
+    return branches;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " listing.txt output.h" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "Can't read " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        lines.push_back(line);
+    }
+
+    const auto boxes = FindBoxes(lines);
+
+    std::vector<std::string> rows(MICROWORD_COUNT);
+    for (const auto& box : boxes) {
+        if (!IsLabel(box.label) || box.label == "trap0" || box.label == "a1") {
+            continue;
+        }
+        const auto branches = Successors(lines, boxes, box);
+        if (branches.empty()) {
+            std::cerr << "No successor for " << box.label << std::endl;
+            return 1;
+        }
+        for (const auto& branch : branches) {
+            if (!IsLabel(branch.target)) {
+                std::cerr << "Unknown successor " << branch.target << " of " << box.label << std::endl;
+                return 1;
+            }
+        }
+
+        std::string condition = "Always";
+        std::vector<std::string> next = {branches[0].target};
+        if (branches.size() > 1u) {
+            const auto form = std::ranges::find_if(CONDITION_FORMS, [&](const ConditionForm& f) {
+                return f.order.size() == branches.size() && std::ranges::all_of(branches, [&](const Branch& b) {
+                    return std::ranges::find(f.order, b.condition) != f.order.end();
+                });
+            });
+            if (form == CONDITION_FORMS.end()) {
+                std::cerr << "Unknown branch conditions of " << box.label << std::endl;
+                return 1;
+            }
+            condition = form->condition;
+            next.clear();
+            for (const auto& c : form->order) {
+                next.push_back(std::ranges::find(branches, c, &Branch::condition)->target);
+            }
+        }
+        while (next.size() < 3u) {
+            next.push_back(next.back());
+        }
+
+        const auto nanoword = NANOWORD_OVERRIDES.contains(box.label) ? NANOWORD_OVERRIDES.at(box.label) : Upper(box.nanoword);
+        rows[LabelValue(box.label)] = "    { Nanoword::" + nanoword + ", Condition::" + condition + ", { " +
+                                      Upper(next[0]) + ", " + Upper(next[1]) + ", " + Upper(next[2]) + " } }, // " +
+                                      Upper(box.label) + " at " + box.address + "\n";
+    }
+    rows[TRAP0] = "    { Nanoword::Exit, Condition::Always, { TRAP0, TRAP0, TRAP0 } }, // TRAP0\n";
+    rows[A1] = "    { Nanoword::Exit, Condition::Always, { A1, A1, A1 } }, // A1\n";
+    // The ROM only covers the division microcode, the other microwords leave it like the exits
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        if (rows[i].empty() && std::ranges::none_of(LABELS, [&](const Label& label) { return label.value == i; })) {
+            rows[i] = std::string("    { Nanoword::Exit, Condition::Always, { A1, A1, A1 } }, // ") + MICROWORD_NAMES[i] + "\n";
+        }
+    }
+
+    for (const auto& label : LABELS) {
+        if (rows[label.value].empty()) {
+            std::cerr << "No microword " << label.name << " in the listing" << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream out(argv[2]);
+    out << "// Generated by 68000_Division_RomGen from the Appendix F listing, do not edit\n"
+           "// Included by 68000_Rom.h after the definition of RomEntry\n\n"
+           "#pragma once\n\n"
+           "inline constexpr RomEntry MICROCODE_ROM[MICROWORD_COUNT] = {\n";
+    for (const auto& row : rows) {
+        out << row;
+    }
+    out << "};\n";
+
+    return out ? 0 : 1;
+}
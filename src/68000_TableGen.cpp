@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "68000.h"
+#include "68000_Tables.h"
+
+// Generates the definitions for 68000_Tables.h by running the microcode for a representative of each entry
+
+namespace {
+
+auto MicrocodeCycles(uint32_t dividend, uint16_t divisor, bool isSigned) -> uint32_t {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    if (isSigned) {
+        mc68000.ExecuteDivs();
+    } else {
+        mc68000.ExecuteDivu();
+    }
+    return mc68000.cycles;
+}
+
+auto WriteTable(std::ostream& out, const std::string& indent, auto cycles) -> void {
+    for (auto pattern = 0u; pattern < QUOTIENT_PATTERNS; ++pattern) {
+        out << ((pattern % 32u == 0u) ? indent : " ") << cycles(pattern) << ",";
+        if (pattern % 32u == 31u) {
+            out << "\n";
+        }
+    }
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " output.cpp" << std::endl;
+        return 2;
+    }
+    std::ofstream out(argv[1]);
+
+    out << "// Generated by 68000_Division_TableGen, do not edit\n\n"
+           "#include \"68000_Tables.h\"\n\n";
+
+    // A quotient of (pattern << 1) | 1 with divisor 1 reaches every pattern without the remainder msb
+    // being shifted out and keeps the dividend negative when it's negated
+    out << "const uint8_t DIVU_CYCLES[QUOTIENT_PATTERNS] = {\n";
+    WriteTable(out, "    ", [](uint32_t pattern) {
+        return MicrocodeCycles(pattern << 1u | 1u, 1u, false);
+    });
+    out << "};\n\n";
+    out << "const uint8_t DIVU_ZERO_CYCLES = " << MicrocodeCycles(0u, 0u, false) << ";\n";
+    out << "const uint8_t DIVU_OVERFLOW_CYCLES = " << MicrocodeCycles(0x1'0000u, 1u, false) << ";\n\n";
+
+    out << "const uint8_t DIVS_CYCLES[4][QUOTIENT_PATTERNS] = {\n";
+    for (auto signs = 0u; signs < 4u; ++signs) {
+        const auto divisor = static_cast<uint16_t>((signs & 2u) ? -1 : 1);
+        out << "    {\n";
+        WriteTable(out, "        ", [&](uint32_t pattern) {
+            const auto quotient = pattern << 1u | 1u;
+            return MicrocodeCycles((signs & 1u) ? 0u - quotient : quotient, divisor, true);
+        });
+        out << "    },\n";
+    }
+    out << "};\n\n";
+    out << "const uint8_t DIVS_ZERO_CYCLES = " << MicrocodeCycles(0u, 0u, true) << ";\n";
+    out << "const uint8_t DIVS_OVERFLOW_CYCLES[2] = { "
+        << MicrocodeCycles(0x1'0000u, 1u, true) << ", "
+        << MicrocodeCycles(0u - 0x1'0000u, 1u, true) << " };\n";
+
+    return out ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "68000_Cycles.h"
+
+// Cycle tables for the division microcode, generated at build time by 68000_Division_TableGen
+// which runs the microcode for every entry.
+//
+// The main loop timing only depends on which iterations restore the remainder, that is the quotient bits 15 to 1.
+// The table entries are full instruction cycle counts, so a lookup replaces the loop entirely, except for DIVU
+// divisors above 0x8000 which add the 15 step DivuShiftedOutBits (see 68000_Cycles.h).
+// 68000_Division_TableCheck checks them against the reference models.
+
+constexpr auto QUOTIENT_PATTERNS = 0x8000u; // Quotient bits 15 to 1
+
+// DIVU, for divisors up to 0x8000 where the remainder msb is never shifted out
+extern const uint8_t DIVU_CYCLES[QUOTIENT_PATTERNS];
+extern const uint8_t DIVU_ZERO_CYCLES;
+extern const uint8_t DIVU_OVERFLOW_CYCLES;
+
+// DIVS, indexed by sign class (negative divisor << 1 | negative dividend)
+// and the quotient bits 15 to 1 of the absolute quotient.
+// The late overflow exits take as long as the sign correction so they share these entries.
+extern const uint8_t DIVS_CYCLES[4][QUOTIENT_PATTERNS];
+extern const uint8_t DIVS_ZERO_CYCLES;
+extern const uint8_t DIVS_OVERFLOW_CYCLES[2]; // Indexed by negative dividend
+
+inline auto DivuTableCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    if (divisor == 0u) {
+        return DIVU_ZERO_CYCLES;
+    }
+    if ((dividend >> 16u) >= divisor) {
+        return DIVU_OVERFLOW_CYCLES;
+    }
+    const auto quotient = dividend / divisor;
+    const auto cycles = DIVU_CYCLES[quotient >> 1u];
+    // Above 0x8000 every quotient bit produced by shifting out the remainder msb skips DVUMB
+    return cycles - 2u * DivuShiftedOutBits(quotient, dividend % divisor, divisor);
+}
+
+inline auto DivsTableCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    if (divisor == 0u) {
+        return DIVS_ZERO_CYCLES;
+    }
+    const auto negativeDividend = dividend >> 31u;
+    const auto negativeDivisor = static_cast<uint32_t>(divisor >> 15u);
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - divisor : divisor);
+    if ((absDividend >> 16u) >= absDivisor) {
+        return DIVS_OVERFLOW_CYCLES[negativeDividend];
+    }
+    return DIVS_CYCLES[negativeDivisor << 1u | negativeDividend][(absDividend / absDivisor) >> 1u];
+}
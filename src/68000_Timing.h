@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "68000_Cycles.h"
+#include "68000_Tables.h"
+
+// Whole instruction timing of DIVU, DIVS, MULU and MULS for every effective address mode.
+//
+// The microcode only covers the register to register core. A memory or immediate source reads the word
+// first (adrw1, e#w1 and so on) and then enters the same core through DVUM1 in place of DVUR1 (or DVS02,
+// MULM1), which takes as long, so the effective address time simply adds to the core.
+// A zero divisor leaves the core at TRAP0 for the divide by zero exception: stacking, vector fetch and
+// prefetch of the handler. An address register source is an illegal instruction.
+//
+// Cross-checked against docs-third-party/Yacht.txt:
+//     effective address times from the operand effective address calculation table (.B or .W)
+//     DIVU overflow 10 cycles, DIVS overflow 16 or 18, divide by zero 38 + ea, illegal instruction 34
+// The DIVU and DIVS rows of Yacht.txt give #<data> as 8(2/0), unlike the general table, the MULU/MULS rows
+// and the single immediate word e#w1 reads; 4(1/0) is used.
+
+enum class EaMode : uint8_t {
+    DataRegister, // Dn
+    AddressRegister, // An
+    Indirect, // (An)
+    PostIncrement, // (An)+
+    PreDecrement, // -(An)
+    Displacement, // (d16,An)
+    Indexed, // (d8,An,Xn)
+    AbsoluteShort, // (xxx).W
+    AbsoluteLong, // (xxx).L
+    PcDisplacement, // (d16,PC)
+    PcIndexed, // (d8,PC,Xn)
+    Immediate, // #<data>
+    Invalid, // Mode 7 with register 5 to 7
+};
+
+constexpr auto EA_MODE_COUNT = 13u;
+
+// Decodes the mode and register fields, bits 5 to 0 of the opcode
+constexpr auto DecodeEaMode(uint16_t field) -> EaMode {
+    const auto mode = (field >> 3u) & 7u;
+    if (mode < 7u) {
+        return static_cast<EaMode>(mode);
+    }
+    const auto reg = field & 7u;
+    return (reg < 5u) ? static_cast<EaMode>(static_cast<uint32_t>(EaMode::AbsoluteShort) + reg) : EaMode::Invalid;
+}
+
+// Word operand effective address calculation times
+constexpr uint8_t EA_WORD_CYCLES[EA_MODE_COUNT] = {
+    0u, 0u, 4u, 4u, 6u, 8u, 10u, 8u, 12u, 8u, 10u, 4u, 0u,
+};
+
+constexpr auto DIVIDE_BY_ZERO_EXCEPTION_CYCLES = 34u; // From TRAP0, the 4 cycles before it are in the core
+constexpr auto ILLEGAL_INSTRUCTION_CYCLES = 34u;
+
+enum class TimedInstruction : uint8_t {
+    None, // Not DIVU, DIVS, MULU or MULS
+    Divu,
+    Divs,
+    Mulu,
+    Muls,
+    Illegal, // An address register or invalid mode 7 source
+};
+
+struct OpcodeTiming {
+    TimedInstruction instruction;
+    uint8_t eaCycles;
+};
+
+// Index of an opcode into OPCODE_TIMING: MUL/DIV, signed and the effective address field
+constexpr auto OpcodeTimingIndex(uint16_t opcode) -> uint32_t {
+    return (opcode >> 14u & 1u) << 7u | (opcode >> 8u & 1u) << 6u | (opcode & 0x3Fu);
+}
+
+constexpr auto IsTimedOpcode(uint16_t opcode) -> bool {
+    // 1000 xxx s11 and 1100 xxx s11
+    return (opcode & 0xB0C0u) == 0x80C0u;
+}
+
+constexpr auto OPCODE_TIMING = [] {
+    std::array<OpcodeTiming, 256u> table{};
+    for (auto index = 0u; index < table.size(); ++index) {
+        const auto multiply = (index >> 7u) & 1u;
+        const auto isSigned = (index >> 6u) & 1u;
+        const auto mode = DecodeEaMode(static_cast<uint16_t>(index & 0x3Fu));
+        if (mode == EaMode::AddressRegister || mode == EaMode::Invalid) {
+            table[index] = { TimedInstruction::Illegal, 0u };
+            continue;
+        }
+        const auto instruction = multiply ?
+                                 (isSigned ? TimedInstruction::Muls : TimedInstruction::Mulu) :
+                                 (isSigned ? TimedInstruction::Divs : TimedInstruction::Divu);
+        table[index] = { instruction, EA_WORD_CYCLES[static_cast<uint32_t>(mode)] };
+    }
+    return table;
+}();
+
+// Cycles for the whole instruction, source is the operand read through the effective address
+// and destination the whole data register (the dividend, or the multiplicand in its low word)
+inline auto InstructionCycles(uint16_t opcode, uint32_t destination, uint16_t source) -> uint32_t {
+    if (!IsTimedOpcode(opcode)) {
+        return 0u;
+    }
+    const auto& timing = OPCODE_TIMING[OpcodeTimingIndex(opcode)];
+    switch (timing.instruction) {
+        case TimedInstruction::Divu:
+            return timing.eaCycles + DivuTableCycles(destination, source) +
+                   ((source == 0u) ? DIVIDE_BY_ZERO_EXCEPTION_CYCLES : 0u);
+        case TimedInstruction::Divs:
+            return timing.eaCycles + DivsTableCycles(destination, source) +
+                   ((source == 0u) ? DIVIDE_BY_ZERO_EXCEPTION_CYCLES : 0u);
+        case TimedInstruction::Mulu:
+            return timing.eaCycles + MuluCycles(source);
+        case TimedInstruction::Muls:
+            return timing.eaCycles + MulsCycles(source);
+        case TimedInstruction::Illegal:
+            return ILLEGAL_INSTRUCTION_CYCLES;
+        case TimedInstruction::None:
+            break;
+    }
+    return 0u;
+}
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+#include "68000_Cycles.h"
+#include "68000_TimingIndex.h"
+
+namespace {
+
+constexpr auto NO_EDGE = uint8_t{ 0xFFu };
+constexpr auto QUOTIENTS = 0x1'0000u;
+
+struct Match {
+    uint64_t required; // Edges
+    std::optional<uint32_t> cycles;
+
+    auto operator()(uint64_t edges, uint32_t divisionCycles) const -> bool {
+        return (edges & required) == required && (!cycles || *cycles == divisionCycles);
+    }
+};
+
+// The remainder from which DIVU quotient bit j comes from a shifted out msb, by j, divisor if never.
+// The remainder before bit j is produced is ((quotient mod 2^(j + 1)) * divisor + remainder) >> (j + 1),
+// see DivuShiftedOutBits
+auto DivuThresholds(uint32_t quotient, uint16_t divisor) -> std::array<uint32_t, 16u> {
+    std::array<uint32_t, 16u> thresholds{};
+    for (auto j = 0u; j < 16u; ++j) {
+        const auto low = static_cast<int64_t>(quotient & ((2u << j) - 1u)) * divisor;
+        thresholds[j] = static_cast<uint32_t>(std::clamp((int64_t{ 0x8000 } << (j + 1u)) - low, int64_t{ 0 },
+                                                         int64_t{ divisor }));
+    }
+    return thresholds;
+}
+
+// Calls run(first, end, shifted) for each run of remainders with the same quotient bits from a shifted out msb
+template<typename Run>
+auto DivuRemainderRuns(uint32_t quotient, uint16_t divisor, Run run) -> bool {
+    const auto thresholds = DivuThresholds(quotient, divisor);
+    std::array<uint32_t, 16u> order{}; // Bits by threshold
+    for (auto j = 0u; j < 16u; ++j) {
+        order[j] = j;
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return thresholds[a] < thresholds[b]; });
+    auto shifted = 0u;
+    auto i = 0u;
+    for (auto start = 0u; start < divisor;) {
+        for (; i < 16u && thresholds[order[i]] <= start; ++i) {
+            shifted |= 1u << order[i];
+        }
+        const auto end = (i < 16u) ? thresholds[order[i]] : static_cast<uint32_t>(divisor);
+        if (!run(start, end, shifted)) {
+            return false;
+        }
+        start = end;
+    }
+    return true;
+}
+
+}
+
+auto TimingIndex::Instruction::Edge(uint32_t from, uint32_t to) const -> EdgeMask {
+    return (bits[from][to] != NO_EDGE) ? EdgeMask{ 1u } << bits[from][to] : 0u;
+}
+
+TimingIndex::TimingIndex() {
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        auto& index = (instruction == DivisionInstruction::Divs) ? divs : divu;
+        index.edges = CoverageEdgesOf(instruction);
+        for (auto& row : index.bits) {
+            row.fill(NO_EDGE);
+        }
+        // Both instructions have fewer edges than the bits of a mask, a ROM with more needs a wider EdgeMask
+        if (index.edges.size() > std::numeric_limits<EdgeMask>::digits) {
+            std::fprintf(stderr, "%s has %zu microword edges, more than the %d bits of an edge mask\n",
+                         (instruction == DivisionInstruction::Divs) ? "DIVS" : "DIVU", index.edges.size(),
+                         std::numeric_limits<EdgeMask>::digits);
+            std::abort();
+        }
+        for (auto i = 0u; i < index.edges.size(); ++i) {
+            index.bits[index.edges[i].first][index.edges[i].second] = static_cast<uint8_t>(i);
+        }
+    }
+
+    divuEdges.resize(QUOTIENTS);
+    divuShiftedEdges.resize(QUOTIENTS);
+    divuCycles.resize(QUOTIENTS);
+    for (auto quotient = 0u; quotient < QUOTIENTS; ++quotient) {
+        // Only a 1 bit can come from a shifted out msb, and each bit takes its edges on its own
+        divuEdges[quotient] = DivuEdges(quotient, 0u);
+        divuShiftedEdges[quotient] = divuEdges[quotient] | DivuEdges(quotient, quotient);
+        divuCycles[quotient] = DivuCycles(quotient, 1u);
+    }
+    for (auto signs = 0u; signs < 4u; ++signs) {
+        const auto negativeDivisor = (signs & 2u) != 0u;
+        const auto negativeDividend = (signs & 1u) != 0u;
+        divsEdges[signs].resize(QUOTIENTS);
+        divsCycles[signs].resize(QUOTIENTS);
+        for (auto quotient = 0u; quotient < QUOTIENTS; ++quotient) {
+            // Divided by 2 so the absolute dividend is never 0
+            const auto absDividend = 2u * quotient + 1u;
+            divsEdges[signs][quotient] = DivsEdges(negativeDivisor, negativeDividend, quotient);
+            divsCycles[signs][quotient] = DivsCycles(negativeDividend ? 0u - absDividend : absDividend,
+                                                     negativeDivisor ? 0xFFFEu : 2u);
+        }
+    }
+}
+
+// Quotient bits 15 to 1 each loop back to DVUM5 (0) or DVUM6 (1), bit 0 leaves through DVUMD (1) or DVUMF (0).
+// A bit from a shifted out msb takes DVUM7 in place of DVUM8 and the test of the borrow
+auto TimingIndex::DivuEdges(uint32_t quotient, uint32_t shifted) const -> EdgeMask {
+    auto edges = divu.Edge(DVUR1, DVUM2) | divu.Edge(DVUM2, DVUM3) | divu.Edge(DVUM3, DVUM5);
+    auto entry = DVUM5;
+    for (auto j = 15u; j >= 1u; --j) {
+        const auto bit = (quotient >> j) & 1u;
+        if ((shifted >> j) & 1u) {
+            edges |= divu.Edge(entry, DVUM7) | divu.Edge(DVUM7, DVUM6);
+        } else {
+            edges |= divu.Edge(entry, DVUM8) | divu.Edge(DVUM8, DVUMB) |
+                     (bit ? divu.Edge(DVUMB, DVUM6) : divu.Edge(DVUMB, DVUME) | divu.Edge(DVUME, DVUM5));
+        }
+        entry = bit ? DVUM6 : DVUM5;
+    }
+    if (shifted & 1u) {
+        edges |= divu.Edge(entry, DVUM7) | divu.Edge(DVUM7, DVUM9) | divu.Edge(DVUM9, DVUMD) |
+                 divu.Edge(DVUMD, DVUM0);
+    } else if (quotient & 1u) {
+        edges |= divu.Edge(entry, DVUM8) | divu.Edge(DVUM8, DVUMC) | divu.Edge(DVUMC, DVUMD) |
+                 divu.Edge(DVUMD, DVUM0);
+    } else {
+        edges |= divu.Edge(entry, DVUM8) | divu.Edge(DVUM8, DVUMC) | divu.Edge(DVUMC, DVUMF) |
+                 divu.Edge(DVUMF, DVUM0);
+    }
+    return edges | divu.Edge(DVUM0, A1);
+}
+
+// Up to DVS08, which branches to the main loop or the early overflow exit
+auto TimingIndex::DivsPrefixEdges(bool negativeDivisor, bool negativeDividend) const -> EdgeMask {
+    const auto setup = negativeDivisor ? DVS05 : DVS04;
+    auto edges = divs.Edge(DVS01, DVS03) | divs.Edge(DVS03, setup) | divs.Edge(setup, DVS06);
+    if (negativeDividend) {
+        return edges | divs.Edge(DVS06, DVS10) | divs.Edge(DVS10, DVS11) | divs.Edge(DVS11, DVS08);
+    }
+    return edges | divs.Edge(DVS06, DVS07) | divs.Edge(DVS07, DVS08);
+}
+
+// Quotient bits 15 to 1 each loop back to DVS09 (0) or DVS0A (1), bit 0 leaves through DVS12 (0) or DVS13 (1).
+// The sign correction overflows on quotient bit 15 for a positive quotient and above 0x8000 for a negative one
+auto TimingIndex::DivsEdges(bool negativeDivisor, bool negativeDividend, uint32_t quotient) const -> EdgeMask {
+    auto edges = DivsPrefixEdges(negativeDivisor, negativeDividend) | divs.Edge(DVS08, DVS09);
+    auto entry = DVS09;
+    for (auto j = 15u; j >= 1u; --j) {
+        const auto bit = (quotient >> j) & 1u;
+        edges |= divs.Edge(entry, DVS0C) | divs.Edge(DVS0C, DVS0D) |
+                 (bit ? divs.Edge(DVS0D, DVS0A) : divs.Edge(DVS0D, DVS0F) | divs.Edge(DVS0F, DVS09));
+        entry = bit ? DVS0A : DVS09;
+    }
+    const auto last = (quotient & 1u) ? DVS13 : DVS12;
+    edges |= divs.Edge(entry, DVS0C) | divs.Edge(DVS0C, DVS0E) | divs.Edge(DVS0E, last) | divs.Edge(last, DVS14) |
+             divs.Edge(DVS14, DVS15);
+
+    const auto overflow = (negativeDivisor == negativeDividend) ? (quotient & 0x8000u) != 0u : quotient > 0x8000u;
+    const auto write = divs.Edge(LEAA2, A1);
+    const auto exit = divs.Edge(DVUMA, A1);
+    if (negativeDivisor && negativeDividend) {
+        edges |= divs.Edge(DVS15, DVS1D) | divs.Edge(DVS1D, DVS1E) |
+                 (overflow ? divs.Edge(DVS1E, DVUM4) | divs.Edge(DVUM4, DVUMA) | exit :
+                             divs.Edge(DVS1E, DVS1C) | divs.Edge(DVS1C, LEAA2) | write);
+    } else if (negativeDivisor) {
+        edges |= divs.Edge(DVS15, DVS1D) | divs.Edge(DVS1D, DVS1F) | divs.Edge(DVS1F, DVS20) |
+                 (overflow ? divs.Edge(DVS20, DVUMA) | exit : divs.Edge(DVS20, LEAA2) | write);
+    } else if (negativeDividend) {
+        edges |= divs.Edge(DVS15, DVS16) | divs.Edge(DVS16, DVS1A) | divs.Edge(DVS1A, DVS1B) |
+                 (overflow ? divs.Edge(DVS1B, DVUM4) | divs.Edge(DVUM4, DVUMA) | exit :
+                             divs.Edge(DVS1B, DVS1C) | divs.Edge(DVS1C, LEAA2) | write);
+    } else {
+        edges |= divs.Edge(DVS15, DVS16) | divs.Edge(DVS16, DVS17) |
+                 (overflow ? divs.Edge(DVS17, DVUMA) | exit : divs.Edge(DVS17, LEAA2) | write);
+    }
+    return edges;
+}
+
+auto TimingIndex::Classify(DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) const
+    -> std::pair<EdgeMask, uint32_t> {
+    if (instruction == DivisionInstruction::Divu) {
+        if (divisor == 0u) {
+            return { divu.Edge(DVUR1, DVUM2) | divu.Edge(DVUM2, TRAP0), DivuCycles(dividend, divisor) };
+        }
+        if ((dividend >> 16u) >= divisor) {
+            return { divu.Edge(DVUR1, DVUM2) | divu.Edge(DVUM2, DVUM3) | divu.Edge(DVUM3, DVUM4) |
+                     divu.Edge(DVUM4, DVUMA) | divu.Edge(DVUMA, A1), DivuCycles(dividend, divisor) };
+        }
+        const auto quotient = dividend / divisor;
+        const auto remainder = dividend % divisor;
+        const auto thresholds = DivuThresholds(quotient, divisor);
+        auto shifted = 0u;
+        for (auto j = 0u; j < 16u; ++j) {
+            shifted |= (remainder >= thresholds[j]) ? 1u << j : 0u;
+        }
+        return { DivuEdges(quotient, shifted),
+                 divuCycles[quotient] - 2u * static_cast<uint32_t>(std::popcount(shifted & 0xFFFEu)) };
+    }
+    if (divisor == 0u) {
+        return { divs.Edge(DVS01, DVS03) | divs.Edge(DVS03, TRAP0), DivsCycles(dividend, divisor) };
+    }
+    const auto negativeDividend = (dividend & 0x8000'0000u) != 0u;
+    const auto negativeDivisor = (divisor & 0x8000u) != 0u;
+    const auto absDividend = negativeDividend ? 0u - dividend : dividend;
+    const auto absDivisor = static_cast<uint16_t>(negativeDivisor ? 0u - divisor : divisor);
+    if ((absDividend >> 16u) >= absDivisor) {
+        return { DivsPrefixEdges(negativeDivisor, negativeDividend) | divs.Edge(DVS08, DVUMZ) |
+                 divs.Edge(DVUMZ, DVUMA) | divs.Edge(DVUMA, A1), DivsCycles(dividend, divisor) };
+    }
+    const auto signs = (negativeDivisor ? 2u : 0u) + (negativeDividend ? 1u : 0u);
+    const auto quotient = absDividend / absDivisor;
+    return { divsEdges[signs][quotient], divsCycles[signs][quotient] };
+}
+
+auto TimingIndex::PathOf(DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) const -> CoveragePath {
+    const auto& index = (instruction == DivisionInstruction::Divs) ? divs : divu;
+    const auto [edges, cycles] = Classify(instruction, dividend, divisor);
+    CoveragePath path{ {}, cycles };
+    for (auto i = 0u; i < index.edges.size(); ++i) {
+        if ((edges >> i) & 1u) {
+            path.edges.push_back(index.edges[i]);
+        }
+    }
+    return path;
+}
+
+// The fixed paths are matched by a division of them, the quotients through the tables. The runs of a divisor
+// are in order of dividend
+template<typename Visit>
+auto TimingIndex::Runs(const TimingQuery& query, Visit visit) const -> void {
+    const auto& index = (query.instruction == DivisionInstruction::Divs) ? divs : divu;
+    Match match{ 0u, query.cycles };
+    for (const auto& [from, to] : query.edges) {
+        const auto edge = (from < MICROWORD_COUNT && to < MICROWORD_COUNT) ? index.Edge(from, to) : 0u;
+        if (edge == 0u) {
+            return; // Never taken
+        }
+        match.required |= edge;
+    }
+    const auto matches = [&](uint32_t dividend, uint16_t divisor) {
+        const auto [edges, cycles] = Classify(query.instruction, dividend, divisor);
+        return match(edges, cycles);
+    };
+    const auto all = uint64_t{ 1 } << 32u;
+
+    if (query.instruction == DivisionInstruction::Divu) {
+        std::vector<uint16_t> quotients;
+        std::vector<uint16_t> shiftedQuotients; // Divisors above 0x8000, one of the runs may match
+        for (auto quotient = 0u; quotient < QUOTIENTS; ++quotient) {
+            if (match(divuEdges[quotient], divuCycles[quotient])) {
+                quotients.push_back(static_cast<uint16_t>(quotient));
+            }
+            const auto fewest = divuCycles[quotient] - 2u * static_cast<uint32_t>(std::popcount(quotient & 0xFFFEu));
+            if ((divuShiftedEdges[quotient] & match.required) == match.required &&
+                (!query.cycles || (*query.cycles >= fewest && *query.cycles <= divuCycles[quotient]))) {
+                shiftedQuotients.push_back(static_cast<uint16_t>(quotient));
+            }
+        }
+        for (auto divisor = uint32_t{ query.firstDivisor }; divisor <= query.lastDivisor; ++divisor) {
+            const auto d = static_cast<uint16_t>(divisor);
+            if (divisor == 0u) {
+                if (matches(0u, d) && !visit(OperandRun{ 0u, all, d })) {
+                    return;
+                }
+                continue;
+            }
+            if (divisor <= 0x8000u) {
+                for (const auto quotient : quotients) {
+                    if (!visit(OperandRun{ quotient * divisor, divisor, d })) {
+                        return;
+                    }
+                }
+            } else {
+                for (const auto quotient : shiftedQuotients) {
+                    const auto lowest = quotient * divisor;
+                    const auto more = DivuRemainderRuns(quotient, d, [&](uint32_t start, uint32_t end, uint32_t shifted) {
+                        const auto cycles = divuCycles[quotient] - 2u * static_cast<uint32_t>(std::popcount(shifted & 0xFFFEu));
+                        return !match(DivuEdges(quotient, shifted), cycles) ||
+                               visit(OperandRun{ lowest + start, end - start, d });
+                    });
+                    if (!more) {
+                        return;
+                    }
+                }
+            }
+            if (matches(divisor << 16u, d) &&
+                !visit(OperandRun{ divisor << 16u, all - (uint64_t{ divisor } << 16u), d })) {
+                return;
+            }
+        }
+        return;
+    }
+
+    std::array<std::vector<uint16_t>, 4u> quotients;
+    for (auto signs = 0u; signs < 4u; ++signs) {
+        for (auto quotient = 0u; quotient < QUOTIENTS; ++quotient) {
+            if (match(divsEdges[signs][quotient], divsCycles[signs][quotient])) {
+                quotients[signs].push_back(static_cast<uint16_t>(quotient));
+            }
+        }
+    }
+    for (auto divisor = uint32_t{ query.firstDivisor }; divisor <= query.lastDivisor; ++divisor) {
+        const auto d = static_cast<uint16_t>(divisor);
+        if (divisor == 0u) {
+            if (matches(0u, d) && !visit(OperandRun{ 0u, all, d })) {
+                return;
+            }
+            continue;
+        }
+        const auto negativeDivisor = (divisor & 0x8000u) != 0u;
+        const auto absDivisor = negativeDivisor ? 0x1'0000u - divisor : divisor;
+        const auto divisions = absDivisor << 16u; // Absolute dividends that don't overflow
+        const auto signs = negativeDivisor ? 2u : 0u;
+        // Positive dividends, then the negative ones from the most negative
+        for (const auto quotient : quotients[signs]) {
+            if (!visit(OperandRun{ quotient * absDivisor, absDivisor, d })) {
+                return;
+            }
+        }
+        if (divisions <= 0x7FFF'FFFFu && matches(0x7FFF'FFFFu, d) &&
+            !visit(OperandRun{ divisions, 0x8000'0000u - divisions, d })) {
+            return;
+        }
+        if (matches(0x8000'0000u, d) && !visit(OperandRun{ 0x8000'0000u, 0x8000'0001u - uint64_t{ divisions }, d })) {
+            return;
+        }
+        for (auto i = quotients[signs + 1u].size(); i > 0u; --i) {
+            const auto quotient = quotients[signs + 1u][i - 1u];
+            // The absolute dividends quotient * absDivisor to that + absDivisor - 1, but not 0
+            const auto first = static_cast<uint32_t>(0u - (quotient * absDivisor + absDivisor - 1u));
+            const auto count = (quotient == 0u) ? absDivisor - 1u : absDivisor;
+            if (count != 0u && !visit(OperandRun{ first, count, d })) {
+                return;
+            }
+        }
+    }
+}
+
+auto TimingIndex::Search(const TimingQuery& query, const OperandFound& found) const -> uint64_t {
+    const auto every = std::max(query.every, uint64_t{ 1 });
+    std::mt19937_64 random(query.seed);
+    const auto pick = [&] { return (query.seed != 0u) ? random() % every : 0u; };
+    auto position = uint64_t{}; // Matches before the run
+    auto next = pick(); // The next match to find
+    auto count = uint64_t{};
+    if (query.limit == 0u) {
+        return 0u;
+    }
+    Runs(query, [&](const OperandRun& run) {
+        for (; next < position + run.count; next = (next / every + 1u) * every + pick()) {
+            ++count;
+            if (!found(static_cast<uint32_t>(run.first + (next - position)), run.divisor) || count == query.limit) {
+                return false;
+            }
+        }
+        position += run.count;
+        return true;
+    });
+    return count;
+}
+
+auto TimingIndex::Count(const TimingQuery& query) const -> uint64_t {
+    auto count = uint64_t{};
+    Runs(query, [&](const OperandRun& run) {
+        count += run.count;
+        return true;
+    });
+    return count;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Batch.h"
+#include "68000_Coverage.h"
+
+// Inverse timing: finds the divisions that take a given number of cycles or a given set of edges between
+// microwords, without running them.
+//
+// Apart from the zero divisor and overflow exits, the path of a division through the microcode only depends on
+//     DIVU: the quotient, and the quotient bits produced from a shifted out remainder msb (divisors above 0x8000)
+//     DIVS: the signs of the operands and the absolute quotient
+// (see 68000_Cycles.h). The index holds the edges and cycles of every quotient pattern, worked out from its bits
+// once. A search goes through the divisors of the query and for each of them through the quotients whose edges
+// and cycles match, every quotient standing for a run of consecutive dividends, one per remainder. For DIVU
+// divisors above 0x8000 the remainders of a quotient split into at most 17 runs at the thresholds where a bit
+// starts coming from a shifted out msb (see AddDivuQuotientCycles); only the quotients one of whose runs can
+// match are split.
+//
+// The matches come in order of divisor and dividend. every and seed thin them out: one match of each
+// consecutive group of every matches is found, the first of the group with seed 0 and a random one otherwise.
+// A query whose matches are rare among the DIVU divisors above 0x8000 walks all their quotients,
+// give it a smaller divisor range.
+
+struct TimingQuery {
+    DivisionInstruction instruction{ DivisionInstruction::Divu };
+    std::optional<uint32_t> cycles{}; // Any cycles when empty
+    std::vector<MicrowordEdge> edges{}; // Every one of them is taken
+    uint16_t firstDivisor{ 0u };
+    uint16_t lastDivisor{ 0xFFFFu };
+    uint64_t limit{ UINT64_MAX }; // Most operands found
+    uint64_t every{ 1u };
+    uint64_t seed{ 0u };
+};
+
+// Returns false to stop the search
+using OperandFound = std::function<bool(uint32_t dividend, uint16_t divisor)>;
+
+class TimingIndex {
+public:
+    TimingIndex();
+
+    // The edges and cycles CoveragePathOf gets by running the microcode
+    auto PathOf(DivisionInstruction, uint32_t dividend, uint16_t divisor) const -> CoveragePath;
+
+    // Returns the number of operands found
+    auto Search(const TimingQuery&, const OperandFound&) const -> uint64_t;
+    // Number of matches, without limit and every
+    auto Count(const TimingQuery&) const -> uint64_t;
+
+private:
+    using EdgeMask = uint64_t; // Bit per edge of the instruction, see CoverageEdgesOf
+
+    // Dividends first to first + count - 1 of divisor
+    struct OperandRun {
+        uint32_t first;
+        uint64_t count;
+        uint16_t divisor;
+    };
+
+    struct Instruction {
+        std::vector<MicrowordEdge> edges;
+        std::array<std::array<uint8_t, MICROWORD_COUNT>, MICROWORD_COUNT> bits; // Of the edges, NO_EDGE if none
+
+        auto Edge(uint32_t from, uint32_t to) const -> EdgeMask;
+    };
+
+    // Calls visit(run) for every run of matches until it returns false
+    template<typename Visit>
+    auto Runs(const TimingQuery&, Visit visit) const -> void;
+
+    auto DivuEdges(uint32_t quotient, uint32_t shifted) const -> EdgeMask;
+    auto DivsEdges(bool negativeDivisor, bool negativeDividend, uint32_t quotient) const -> EdgeMask;
+    auto DivsPrefixEdges(bool negativeDivisor, bool negativeDividend) const -> EdgeMask;
+    auto Classify(DivisionInstruction, uint32_t dividend, uint16_t divisor) const -> std::pair<EdgeMask, uint32_t>;
+
+    Instruction divu;
+    Instruction divs;
+    // DIVU by quotient, without a shifted out msb and with one wherever it can be
+    std::vector<EdgeMask> divuEdges;
+    std::vector<EdgeMask> divuShiftedEdges;
+    std::vector<uint32_t> divuCycles;
+    // DIVS by negative divisor * 2 + negative dividend, then absolute quotient
+    std::array<std::vector<EdgeMask>, 4u> divsEdges;
+    std::array<std::vector<uint32_t>, 4u> divsCycles;
+};
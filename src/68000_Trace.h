@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "68000.h"
+
+// Trace sinks receive the processor state at the points of interest in the division main loops.
+// A sink takes part by providing any of Record(const MC68000&), Step(uint16_t, uint16_t) and
+// Microcycle(const MC68000&); the calls are resolved at compile time, so a sink without them
+// (NullTraceSink) costs nothing.
+
+// With M68K_LAZY_FLAGS the flags are brought up to date first, a sink never sees them pending
+template<typename TraceSink>
+constexpr auto Trace(TraceSink& sink, MC68000& state) -> void {
+    if constexpr (requires { sink.Record(state); }) {
+        state.SyncFlags();
+        sink.Record(state);
+    }
+}
+
+// Called before every microword, state.microword is the microword about to run.
+// Step(previous, next) receives the microword that ran before it (MICROWORD_COUNT before the first),
+// which is kept in previous. Microcycle(state) receives the registers as they are at that point.
+// Without either on the sink neither the calls nor the bookkeeping of previous are compiled in.
+template<typename TraceSink>
+constexpr auto Step(TraceSink& sink, uint16_t& previous, MC68000& state) -> void {
+    if constexpr (requires { sink.Microcycle(state); }) {
+        state.SyncFlags();
+        sink.Microcycle(state);
+    }
+    if constexpr (requires { sink.Step(previous, state.microword); }) {
+        sink.Step(previous, state.microword);
+        previous = state.microword;
+    }
+}
+
+// Tracing disabled
+struct NullTraceSink {};
+
+// Writes the registers to the console, this is the original diagnostic output
+struct ConsoleTraceSink {
+    auto Record(const MC68000& state) const -> void {
+        state.Print();
+    }
+};
+
+struct TraceRecord {
+    uint16_t microword;
+    uint32_t au; // Loop counter
+    uint16_t alu;
+    uint16_t alue;
+    uint16_t alub;
+    uint16_t rxdh;
+    uint16_t rxdl;
+    uint16_t rydl;
+};
+
+// Keeps the most recent records in a fixed size buffer, older records are overwritten
+struct RingTraceSink {
+    std::vector<TraceRecord> records;
+    std::size_t next{}; // Index the next record is written to
+    std::size_t count{}; // Number of valid records
+    uint64_t total{}; // Number of records seen, including those overwritten
+
+    explicit RingTraceSink(std::size_t capacity) : records(capacity) {}
+
+    auto Record(const MC68000& state) -> void {
+        if (records.empty()) {
+            ++total;
+            return;
+        }
+        records[next] = {
+            state.microword,
+            state.au,
+            state.alu,
+            state.alue,
+            state.alub,
+            state.rxdh,
+            state.rxdl,
+            state.rydl
+        };
+        next = (next + 1u == records.size()) ? 0u : next + 1u;
+        count += (count < records.size()) ? 1u : 0u;
+        ++total;
+    }
+
+    auto Size() const -> std::size_t { return count; }
+
+    // Records are indexed oldest first
+    auto operator[](std::size_t i) const -> const TraceRecord& {
+        const auto oldest = (count < records.size()) ? 0u : next;
+        const auto index = oldest + i;
+        return records[(index < records.size()) ? index : index - records.size()];
+    }
+
+    auto Clear() -> void {
+        next = 0u;
+        count = 0u;
+        total = 0u;
+    }
+};
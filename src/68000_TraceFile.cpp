@@ -0,0 +1,157 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define M68K_HAVE_MMAP 1
+#endif
+
+#include "68000_TraceFile.h"
+
+namespace {
+
+auto ValidHeader(const TraceFileHeader& header) -> bool {
+    return std::memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) == 0
+        && header.version == TRACE_FILE_VERSION
+        && header.recordSize == sizeof(MicrocycleRecord);
+}
+
+} // namespace
+
+BinaryTraceSink::BinaryTraceSink(std::size_t bufferRecords) : buffer(bufferRecords > 0u ? bufferRecords : 1u) {}
+
+BinaryTraceSink::~BinaryTraceSink() {
+    Close();
+}
+
+auto BinaryTraceSink::Open(const std::string& path) -> bool {
+    Close();
+    file = std::fopen(path.c_str(), "a+b");
+    if (file == nullptr) {
+        std::cerr << "Can't open trace " << path << '\n';
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        TraceFileHeader header{};
+        std::memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+        header.version = TRACE_FILE_VERSION;
+        header.recordSize = sizeof(MicrocycleRecord);
+        if (std::fwrite(&header, sizeof(header), 1u, file) != 1u) {
+            std::cerr << "Can't write trace " << path << '\n';
+            Close();
+            return false;
+        }
+        return true;
+    }
+    TraceFileHeader header{};
+    std::rewind(file);
+    if (std::fread(&header, sizeof(header), 1u, file) != 1u || !ValidHeader(header)) {
+        std::cerr << path << " isn't a trace of this version\n";
+        Close();
+        return false;
+    }
+    return true;
+}
+
+auto BinaryTraceSink::Close() -> bool {
+    if (file == nullptr) {
+        count = 0u;
+        return true;
+    }
+    auto written = Flush();
+    written = (std::fclose(file) == 0) && written;
+    file = nullptr;
+    return written;
+}
+
+auto BinaryTraceSink::Flush() -> bool {
+    // Records made without an open file are dropped
+    const auto records = count;
+    count = 0u;
+    if (file == nullptr || records == 0u) {
+        return true;
+    }
+    return std::fwrite(buffer.data(), sizeof(MicrocycleRecord), records, file) == records
+        && std::fflush(file) == 0;
+}
+
+MappedTrace::~MappedTrace() {
+    Close();
+}
+
+auto MappedTrace::Open(const std::string& path) -> bool {
+    Close();
+#if M68K_HAVE_MMAP
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor >= 0) {
+        struct stat status{};
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+            auto* address = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address != MAP_FAILED) {
+                mapping = address;
+                mappingSize = static_cast<std::size_t>(status.st_size);
+            }
+        }
+        ::close(descriptor);
+    }
+#endif
+    const char* data = static_cast<const char*>(mapping);
+    std::size_t bytes = mappingSize;
+    std::vector<char> contents;
+    if (mapping == nullptr) {
+        auto* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            std::cerr << "Can't open trace " << path << '\n';
+            return false;
+        }
+        char block[1u << 16u];
+        for (auto read = std::fread(block, 1u, sizeof(block), file); read > 0u; read = std::fread(block, 1u, sizeof(block), file)) {
+            contents.insert(contents.end(), block, block + read);
+        }
+        std::fclose(file);
+        data = contents.data();
+        bytes = contents.size();
+    }
+
+    TraceFileHeader header{};
+    if (bytes < sizeof(header)) {
+        std::cerr << path << " isn't a trace of this version\n";
+        Close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (!ValidHeader(header)) {
+        std::cerr << path << " isn't a trace of this version\n";
+        Close();
+        return false;
+    }
+    size = (bytes - sizeof(header)) / sizeof(MicrocycleRecord);
+    if (mapping != nullptr) {
+        // The header keeps the records aligned within the page aligned mapping
+        records = reinterpret_cast<const MicrocycleRecord*>(data + sizeof(header));
+    } else {
+        copy.resize(size);
+        std::memcpy(copy.data(), data + sizeof(header), size * sizeof(MicrocycleRecord));
+        records = copy.data();
+    }
+    return true;
+}
+
+auto MappedTrace::Close() -> void {
+#if M68K_HAVE_MMAP
+    if (mapping != nullptr) {
+        ::munmap(mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0u;
+    copy.clear();
+    records = nullptr;
+    size = 0u;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "68000.h"
+
+// Binary microcycle traces.
+//
+// A trace file is a TraceFileHeader followed by one MicrocycleRecord per microword run, in the order
+// they ran. The registers are those at the start of the microword and cycles includes the microword.
+// Each division ends with a record of its exit (A1 or TRAP0), whose 2 cycles belong to what follows.
+// Files are only ever appended to, so one file can hold the traces of many divisions.
+
+constexpr char TRACE_FILE_MAGIC[8] = { '6', '8', 'K', 'T', 'R', 'A', 'C', 'E' };
+constexpr auto TRACE_FILE_VERSION = 1u;
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+static_assert(sizeof(TraceFileHeader) == 16u);
+
+struct MicrocycleRecord {
+    uint16_t microword;
+    uint16_t alu;
+    uint16_t alue;
+    uint16_t alub;
+    uint16_t atl;
+    uint16_t ath;
+    uint16_t flags;
+    uint16_t reserved;
+    uint32_t au;
+    uint32_t cycles;
+};
+
+static_assert(sizeof(MicrocycleRecord) == 24u);
+
+// Trace sink appending a MicrocycleRecord for every microword to a trace file.
+// Records are collected in a buffer and written a buffer at a time.
+class BinaryTraceSink {
+public:
+    explicit BinaryTraceSink(std::size_t bufferRecords = 1u << 16u);
+    ~BinaryTraceSink();
+
+    BinaryTraceSink(const BinaryTraceSink&) = delete;
+    auto operator=(const BinaryTraceSink&) -> BinaryTraceSink& = delete;
+
+    // Writes the header if the file is new or empty, returns false if the file can't be opened
+    // or holds something other than a trace
+    auto Open(const std::string& path) -> bool;
+    // Writes the buffered records and closes the file
+    auto Close() -> bool;
+    auto Flush() -> bool;
+
+    auto Microcycle(const MC68000& state) -> void {
+        buffer[count++] = {
+            state.microword,
+            state.alu,
+            state.alue,
+            state.alub,
+            state.atl,
+            state.ath,
+            state.flags,
+            0u,
+            state.au,
+            state.cycles
+        };
+        if (count == buffer.size()) {
+            Flush();
+        }
+    }
+
+private:
+    std::FILE* file{};
+    std::vector<MicrocycleRecord> buffer;
+    std::size_t count{};
+};
+
+// A trace file mapped read only into memory
+class MappedTrace {
+public:
+    MappedTrace() = default;
+    ~MappedTrace();
+
+    MappedTrace(const MappedTrace&) = delete;
+    auto operator=(const MappedTrace&) -> MappedTrace& = delete;
+
+    // Returns false if the file can't be mapped or isn't a trace, a partial record at the end is ignored
+    auto Open(const std::string& path) -> bool;
+    auto Close() -> void;
+
+    auto Size() const -> std::size_t { return size; }
+    auto operator[](std::size_t i) const -> const MicrocycleRecord& { return records[i]; }
+    auto begin() const -> const MicrocycleRecord* { return records; }
+    auto end() const -> const MicrocycleRecord* { return records + size; }
+
+private:
+    void* mapping{};
+    std::size_t mappingSize{};
+    std::vector<MicrocycleRecord> copy; // Where the file can't be mapped it's read instead
+    const MicrocycleRecord* records{};
+    std::size_t size{};
+};
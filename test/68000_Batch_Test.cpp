@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Batch.h"
+
+struct BatchExpectation {
+    std::vector<uint32_t> dividends;
+    std::vector<uint16_t> divisors;
+    std::vector<uint16_t> remainders;
+    std::vector<uint16_t> quotients;
+    std::vector<uint16_t> flags;
+    std::vector<uint32_t> cycles;
+
+    auto Add(uint32_t dividend, uint16_t divisor, bool isSigned) -> void {
+        auto mc68000 = LoadDivision(dividend, divisor);
+        if (isSigned) {
+            mc68000.ExecuteDivs();
+        } else {
+            mc68000.ExecuteDivu();
+        }
+        dividends.push_back(dividend);
+        divisors.push_back(divisor);
+        remainders.push_back(mc68000.rxdh);
+        quotients.push_back(mc68000.rxdl);
+        flags.push_back(mc68000.flags);
+        cycles.push_back(mc68000.cycles);
+    }
+};
+
+// Every divisor with dividends around the quotient and sign boundaries
+auto MakeExpectation(bool isSigned) -> BatchExpectation {
+    BatchExpectation expectation;
+    auto random = 0x1234'5678u;
+    for (auto divisor = 0u; divisor < 0x1'0000u; ++divisor) {
+        const auto absDivisor = (isSigned && (divisor & 0x8000u)) ? 0x1'0000u - divisor : divisor;
+        const uint32_t dividends[] = {
+            0u, 1u, -1u, divisor, -divisor, absDivisor - 1u, absDivisor << 15u, absDivisor << 16u,
+            absDivisor * 0x7FFFu + absDivisor - 1u, absDivisor * 0x8000u, -(absDivisor * 0x8000u),
+            -(absDivisor * 0x8001u), absDivisor * 0xFFFFu + absDivisor - 1u, 0x7FFF'FFFFu, 0x8000'0000u,
+            random = random * 1664525u + 1013904223u
+        };
+        for (const auto dividend : dividends) {
+            expectation.Add(dividend, divisor, isSigned);
+        }
+    }
+    return expectation;
+}
+
+struct BatchTestFixture : public testing::TestWithParam<BatchIsa> {
+    static auto Check(const BatchExpectation& expectation, BatchIsa isa, bool isSigned) -> void {
+        const auto size = expectation.dividends.size();
+        std::vector<uint16_t> remainders(size), quotients(size), flags(size);
+        std::vector<uint32_t> cycles(size);
+        const DivisionOperands operands{ expectation.dividends, expectation.divisors };
+        const DivisionResults results{ remainders, quotients, flags, cycles };
+        if (isSigned) {
+            ExecuteDivsBatch(operands, results, isa);
+        } else {
+            ExecuteDivuBatch(operands, results, isa);
+        }
+        for (auto i = 0u; i < size; ++i) {
+            ASSERT_EQ(remainders[i], expectation.remainders[i]) << "dividend " << expectation.dividends[i] << " divisor " << expectation.divisors[i];
+            ASSERT_EQ(quotients[i], expectation.quotients[i]) << "dividend " << expectation.dividends[i] << " divisor " << expectation.divisors[i];
+            ASSERT_EQ(flags[i], expectation.flags[i]) << "dividend " << expectation.dividends[i] << " divisor " << expectation.divisors[i];
+            ASSERT_EQ(cycles[i], expectation.cycles[i]) << "dividend " << expectation.dividends[i] << " divisor " << expectation.divisors[i];
+        }
+    }
+};
+
+TEST_P(BatchTestFixture, TestUnsignedDivision) {
+    if (!BatchIsaSupported(GetParam())) {
+        GTEST_SKIP() << "Not supported by this processor";
+    }
+    static const auto expectation = MakeExpectation(false);
+    Check(expectation, GetParam(), false);
+}
+
+TEST_P(BatchTestFixture, TestSignedDivision) {
+    if (!BatchIsaSupported(GetParam())) {
+        GTEST_SKIP() << "Not supported by this processor";
+    }
+    static const auto expectation = MakeExpectation(true);
+    Check(expectation, GetParam(), true);
+}
+
+TEST_P(BatchTestFixture, TestPartialBatches) {
+    if (!BatchIsaSupported(GetParam())) {
+        GTEST_SKIP() << "Not supported by this processor";
+    }
+    for (auto size = 0u; size < 40u; ++size) {
+        BatchExpectation unsignedExpectation, signedExpectation;
+        for (auto i = 0u; i < size; ++i) {
+            unsignedExpectation.Add(0x0432'10FFu + i * 0x0101'0101u, 0x5A5Bu + i, false);
+            signedExpectation.Add(0xFFFF'0001u - i * 0x0101'0101u, 0x8000u - i, true);
+        }
+        Check(unsignedExpectation, GetParam(), false);
+        Check(signedExpectation, GetParam(), true);
+    }
+}
+
+TEST_P(BatchTestFixture, TestShortSpans) {
+    const std::vector<uint32_t> dividends{ 0x0001'0000u, 7u, 0xFFFF'FFFFu };
+    const std::vector<uint16_t> divisors{ 3u, 2u, 0xFFFFu };
+    std::vector<uint16_t> remainders(3u), quotients(3u), flags(3u);
+    std::vector<uint32_t> cycles(3u);
+    std::vector<uint16_t> shortFlags(2u, 0x5A5Au);
+    const DivisionOperands operands{ dividends, divisors };
+    EXPECT_THROW(ExecuteDivuBatch(operands, { remainders, quotients, shortFlags, cycles }, GetParam()), std::invalid_argument);
+    EXPECT_THROW(ExecuteDivsBatch({ dividends, { divisors.data(), 2u } }, { remainders, quotients, flags, cycles }, GetParam()),
+                 std::invalid_argument);
+    EXPECT_EQ(shortFlags, std::vector<uint16_t>(2u, 0x5A5Au));
+    EXPECT_EQ(cycles, std::vector<uint32_t>(3u));
+
+    // Longer results are fine, the extra elements are left alone
+    std::vector<uint32_t> longCycles(4u, 1u);
+    ExecuteDivuBatch(operands, { remainders, quotients, flags, longCycles }, GetParam());
+    EXPECT_EQ(longCycles[3], 1u);
+    EXPECT_NE(longCycles[1], 1u);
+}
+
+INSTANTIATE_TEST_SUITE_P(BatchTest, BatchTestFixture, ::testing::Values(
+    BatchIsa::Scalar,
+    BatchIsa::Vector128,
+    BatchIsa::Avx2,
+    BatchIsa::Avx512));
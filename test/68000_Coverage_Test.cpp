@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+
+#include "68000.h"
+#include "68000_Coverage.h"
+#include "68000_Coverage_Vectors.h"
+#include "68000_Reference.h"
+
+// The generated table takes every microword edge and cycle count, so these few divisions check every path
+
+struct CoverageTestFixture : public testing::TestWithParam<CoverageVector> {
+    MC68000 mc68000;
+};
+
+TEST_P(CoverageTestFixture, TestDivision) {
+    const auto& [instruction, dividend, divisor] = GetParam();
+    mc68000 = LoadDivision(dividend, divisor);
+    if (instruction == DivisionInstruction::Divs) {
+        const auto& [remainder, quotient] = DivideSigned(dividend, divisor);
+        mc68000.ExecuteDivs();
+        EXPECT_EQ(mc68000.rxdh, remainder);
+        EXPECT_EQ(mc68000.rxdl, quotient);
+        EXPECT_EQ(mc68000.cycles, (divisor != 0u) ? DivideSignedCycles(dividend, divisor) : 4u);
+    } else {
+        const auto& [remainder, quotient] = DivideUnsigned(dividend, divisor);
+        mc68000.ExecuteDivu();
+        EXPECT_EQ(mc68000.rxdh, remainder);
+        EXPECT_EQ(mc68000.rxdl, quotient);
+        EXPECT_EQ(mc68000.cycles, (divisor != 0u) ? DivideUnsignedCycles(dividend, divisor) : 4u);
+    }
+    // The reference only times the zero divisor from the exception, the microcode runs two microwords to TRAP0
+    EXPECT_EQ(mc68000.microword, (divisor != 0u) ? A1 : TRAP0);
+    EXPECT_EQ(mc68000.rydl, divisor);
+}
+
+INSTANTIATE_TEST_SUITE_P(CoverageTest, CoverageTestFixture, ::testing::ValuesIn(COVERAGE_VECTORS));
+
+TEST(CoverageTest, TestTableCoversGoals) {
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        std::set<MicrowordEdge> edges;
+        std::set<uint32_t> cycles;
+        for (const auto& vector : COVERAGE_VECTORS) {
+            if (vector.instruction == instruction) {
+                const auto path = CoveragePathOf(vector);
+                edges.insert(path.edges.begin(), path.edges.end());
+                cycles.insert(path.cycles);
+            }
+        }
+        const auto goals = CoverageGoalsOf(instruction);
+        for (const auto& [from, to] : goals.edges) {
+            EXPECT_TRUE(edges.contains({ from, to })) << MICROWORD_NAMES[from] << " to " << MICROWORD_NAMES[to];
+        }
+        for (const auto c : goals.cycles) {
+            EXPECT_TRUE(cycles.contains(c)) << c << " cycles";
+        }
+        // Nothing outside the goals, or the ROM and the interpreter disagree
+        EXPECT_EQ(edges.size(), goals.edges.size());
+        EXPECT_EQ(cycles.size(), goals.cycles.size());
+    }
+}
+
+TEST(CoverageTest, TestGoals) {
+    const auto divu = CoverageGoalsOf(DivisionInstruction::Divu);
+    EXPECT_TRUE(std::ranges::binary_search(divu.edges, MicrowordEdge{ DVUMC, DVUMF }));
+    EXPECT_EQ(divu.cycles.front(), 4u); // Divide by zero
+    EXPECT_EQ(divu.cycles.back(), 136u);
+    const auto divs = CoverageGoalsOf(DivisionInstruction::Divs);
+    for (const auto& edge : { MicrowordEdge{ DVS1B, DVUM4 }, MicrowordEdge{ DVS1E, DVUM4 }, MicrowordEdge{ DVS20, DVUMA } }) {
+        EXPECT_TRUE(std::ranges::binary_search(divs.edges, edge));
+    }
+    EXPECT_EQ(divs.cycles.back(), 156u);
+}
+
+TEST(CoverageTest, TestCandidatesAreValid) {
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        const auto candidates = CoverageCandidates(instruction);
+        EXPECT_FALSE(candidates.empty());
+        for (const auto& candidate : candidates) {
+            EXPECT_EQ(candidate.instruction, instruction);
+        }
+    }
+}
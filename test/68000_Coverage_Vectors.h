@@ -0,0 +1,65 @@
+// Generated by 68000_Division_Coverage, do not edit
+// Takes every edge between the DIVU and DIVS microwords a division can take and every cycle count,
+// see 68000_Coverage.h
+
+#pragma once
+
+#include "68000_Coverage.h"
+
+inline constexpr CoverageVector COVERAGE_VECTORS[] = {
+    { DivisionInstruction::Divu, 0x0000'0000u, 0x0000u }, // 4 cycles, DVUR1>DVUM2 DVUM2>TRAP0
+    { DivisionInstruction::Divu, 0x0001'0000u, 0x0001u }, // 10 cycles, DVUM2>DVUM3 DVUM3>DVUM4 DVUM4>DVUMA DVUMA>A1
+    { DivisionInstruction::Divu, 0x8000'FFFFu, 0x8001u }, // 76 cycles, DVUM3>DVUM5 DVUM5>DVUM7 DVUM6>DVUM7 DVUM7>DVUM6 DVUM7>DVUM9 DVUM9>DVUMD DVUMD>DVUM0 DVUM0>A1
+    { DivisionInstruction::Divu, 0xAAA9'AAAAu, 0xAAABu }, // 78 cycles, DVUM6>DVUM8 DVUM8>DVUMB DVUM8>DVUMC DVUMB>DVUM6 DVUMC>DVUMF DVUMF>DVUM0
+    { DivisionInstruction::Divu, 0x4000'7FFFu, 0x8001u }, // 80 cycles, DVUM5>DVUM8 DVUMB>DVUME DVUME>DVUM5
+    { DivisionInstruction::Divu, 0x6000'BFFFu, 0x8001u }, // 82 cycles
+    { DivisionInstruction::Divu, 0x2000'3FFFu, 0x8001u }, // 84 cycles
+    { DivisionInstruction::Divu, 0x3000'5FFFu, 0x8001u }, // 86 cycles
+    { DivisionInstruction::Divu, 0x1000'1FFFu, 0x8001u }, // 88 cycles
+    { DivisionInstruction::Divu, 0x1800'2FFFu, 0x8001u }, // 90 cycles
+    { DivisionInstruction::Divu, 0x0800'0FFFu, 0x8001u }, // 92 cycles
+    { DivisionInstruction::Divu, 0x0C00'17FFu, 0x8001u }, // 94 cycles
+    { DivisionInstruction::Divu, 0x0400'07FFu, 0x8001u }, // 96 cycles
+    { DivisionInstruction::Divu, 0x0600'0BFFu, 0x8001u }, // 98 cycles
+    { DivisionInstruction::Divu, 0x0200'03FFu, 0x8001u }, // 100 cycles
+    { DivisionInstruction::Divu, 0x0300'05FFu, 0x8001u }, // 102 cycles
+    { DivisionInstruction::Divu, 0x0100'01FFu, 0x8001u }, // 104 cycles
+    { DivisionInstruction::Divu, 0x0000'FFFEu, 0x0001u }, // 106 cycles
+    { DivisionInstruction::Divu, 0x0000'7FFFu, 0x0001u }, // 108 cycles, DVUMC>DVUMD
+    { DivisionInstruction::Divu, 0x0000'3FFFu, 0x0001u }, // 110 cycles
+    { DivisionInstruction::Divu, 0x0000'1FFFu, 0x0001u }, // 112 cycles
+    { DivisionInstruction::Divu, 0x0000'0FFFu, 0x0001u }, // 114 cycles
+    { DivisionInstruction::Divu, 0x0000'07FFu, 0x0001u }, // 116 cycles
+    { DivisionInstruction::Divu, 0x0000'03FFu, 0x0001u }, // 118 cycles
+    { DivisionInstruction::Divu, 0x0000'01FFu, 0x0001u }, // 120 cycles
+    { DivisionInstruction::Divu, 0x0000'00FFu, 0x0001u }, // 122 cycles
+    { DivisionInstruction::Divu, 0x0000'007Fu, 0x0001u }, // 124 cycles
+    { DivisionInstruction::Divu, 0x0000'003Fu, 0x0001u }, // 126 cycles
+    { DivisionInstruction::Divu, 0x0000'001Fu, 0x0001u }, // 128 cycles
+    { DivisionInstruction::Divu, 0x0006'000Bu, 0x8001u }, // 130 cycles
+    { DivisionInstruction::Divu, 0x0000'0007u, 0x0001u }, // 132 cycles
+    { DivisionInstruction::Divu, 0x0000'0003u, 0x0001u }, // 134 cycles
+    { DivisionInstruction::Divu, 0x0000'0000u, 0x0001u }, // 136 cycles
+    { DivisionInstruction::Divs, 0x7FFF'FFFFu, 0x0000u }, // 4 cycles, DVS01>DVS03 DVS03>TRAP0
+    { DivisionInstruction::Divs, 0x7FFF'FFFFu, 0x0001u }, // 16 cycles, DVUMZ>DVUMA DVS03>DVS04 DVS04>DVS06 DVS06>DVS07 DVS07>DVS08 DVS08>DVUMZ
+    { DivisionInstruction::Divs, 0x8000'0000u, 0x0001u }, // 18 cycles, DVS06>DVS10 DVS10>DVS11 DVS11>DVS08
+    { DivisionInstruction::Divs, 0x0000'FFFEu, 0x0001u }, // 120 cycles, DVS08>DVS09 DVS09>DVS0C DVS0A>DVS0C DVS0C>DVS0D DVS0C>DVS0E DVS0D>DVS0A DVS0E>DVS12 DVS12>DVS14 DVS14>DVS15 DVS15>DVS16 DVS16>DVS17 DVS17>DVUMA
+    { DivisionInstruction::Divs, 0x0000'7FFFu, 0x0001u }, // 122 cycles, DVS0D>DVS0F DVS0E>DVS13 DVS0F>DVS09 DVS13>DVS14 DVS17>LEAA2 LEAA2>A1
+    { DivisionInstruction::Divs, 0x8000'8000u, 0x8000u }, // 124 cycles, DVS03>DVS05 DVS05>DVS06 DVS15>DVS1D DVS1D>DVS1E DVS1E>DVUM4
+    { DivisionInstruction::Divs, 0xC000'8000u, 0x8000u }, // 126 cycles, DVS1C>LEAA2 DVS1E>DVS1C
+    { DivisionInstruction::Divs, 0xFFFF'0004u, 0x0001u }, // 128 cycles, DVS16>DVS1A DVS1A>DVS1B DVS1B>DVUM4
+    { DivisionInstruction::Divs, 0xFFFF'C001u, 0x0001u }, // 130 cycles, DVS1B>DVS1C
+    { DivisionInstruction::Divs, 0x0000'03FFu, 0x0001u }, // 132 cycles
+    { DivisionInstruction::Divs, 0x0000'01FFu, 0x0001u }, // 134 cycles
+    { DivisionInstruction::Divs, 0x5555'0000u, 0x8000u }, // 136 cycles, DVS1D>DVS1F DVS1F>DVS20 DVS20>DVUMA
+    { DivisionInstruction::Divs, 0x0000'007Fu, 0x0001u }, // 138 cycles
+    { DivisionInstruction::Divs, 0x0000'003Fu, 0x0001u }, // 140 cycles
+    { DivisionInstruction::Divs, 0x0000'001Fu, 0x0001u }, // 142 cycles
+    { DivisionInstruction::Divs, 0x0000'000Fu, 0x0001u }, // 144 cycles
+    { DivisionInstruction::Divs, 0x0000'0007u, 0x0001u }, // 146 cycles
+    { DivisionInstruction::Divs, 0x0000'8000u, 0x0001u }, // 148 cycles
+    { DivisionInstruction::Divs, 0x0000'0000u, 0x0001u }, // 150 cycles
+    { DivisionInstruction::Divs, 0x0000'8000u, 0x8000u }, // 152 cycles, DVS20>LEAA2
+    { DivisionInstruction::Divs, 0xFFFF'7FFFu, 0x0001u }, // 154 cycles
+    { DivisionInstruction::Divs, 0xFFFF'FFFFu, 0x0001u }, // 156 cycles
+};
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Cycles.h"
+#include "68000_Tables.h"
+
+// The timing of both instructions is fixed by the divisor, the signs of the operands and the quotient, and for
+// DIVU divisors above 0x8000 by the remainders at which a quotient bit starts coming from a shifted out msb.
+// The tests cover every divisor with a few dividends, every quotient of a few divisors, and for DIVU divisors
+// above 0x8000 the remainders on both sides of every such threshold, not every dividend.
+// Both the closed-form counts and the generated tables are checked against the microcode.
+
+auto MicrocodeDivuCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteDivu();
+    return mc68000.cycles;
+}
+
+auto MicrocodeDivsCycles(uint32_t dividend, uint16_t divisor) -> uint32_t {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteDivs();
+    return mc68000.cycles;
+}
+
+TEST(CyclesTest, TestDivuEveryDivisor) {
+    for (auto divisor = 0u; divisor < 0x1'0000u; ++divisor) {
+        const uint32_t dividends[] = {
+            0u, 1u, divisor - 1u, divisor, divisor * 0x5A5Au + divisor / 2u,
+            divisor * 0xFFFFu, divisor * 0xFFFFu + divisor - 1u, divisor << 16u,
+            0x7FFF'FFFFu, 0x8000'0000u, 0xFFFF'FFFFu, divisor * 0x9E37'79B9u
+        };
+        for (const auto dividend : dividends) {
+            ASSERT_EQ(DivuCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+            ASSERT_EQ(DivuTableCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+        }
+    }
+}
+
+TEST(CyclesTest, TestDivuEveryQuotient) {
+    constexpr uint16_t divisors[] = { 1u, 3u, 0x5A5Bu, 0x7FFFu, 0x8000u, 0x8001u, 0xA6A6u, 0xC001u, 0xFFFFu };
+    for (const auto divisor : divisors) {
+        for (auto quotient = 0u; quotient < 0x1'0000u; ++quotient) {
+            for (const auto remainder : { 0u, divisor / 2u, divisor - 1u }) {
+                const auto dividend = quotient * divisor + remainder;
+                ASSERT_EQ(DivuCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                    << "dividend " << dividend << " divisor " << divisor;
+                ASSERT_EQ(DivuTableCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                    << "dividend " << dividend << " divisor " << divisor;
+            }
+        }
+    }
+}
+
+TEST(CyclesTest, TestDivuShiftedOutThresholds) {
+    // Quotient bit j comes from a shifted out msb from remainder 2^(j + 16) - (quotient mod 2^(j + 1)) * divisor,
+    // DivuShiftedOutBits only changes there
+    constexpr uint16_t divisors[] = { 0x8001u, 0x9249u, 0xAAABu, 0xC001u, 0xFFFFu };
+    for (const auto divisor : divisors) {
+        for (auto quotient = 0u; quotient < 0x1'0000u; ++quotient) {
+            std::vector<uint32_t> remainders{ 0u, divisor - 1u };
+            for (auto j = 1u; j < 16u; ++j) {
+                const auto low = uint64_t{ quotient & ((2u << j) - 1u) };
+                const auto threshold = static_cast<int64_t>((uint64_t{ 1 } << (j + 16u)) - low * divisor);
+                if (threshold > 0 && threshold < divisor) {
+                    remainders.push_back(static_cast<uint32_t>(threshold) - 1u);
+                    remainders.push_back(static_cast<uint32_t>(threshold));
+                }
+            }
+            for (const auto remainder : remainders) {
+                const auto dividend = quotient * divisor + remainder;
+                ASSERT_EQ(DivuCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                    << "dividend " << dividend << " divisor " << divisor;
+                ASSERT_EQ(DivuTableCycles(dividend, divisor), MicrocodeDivuCycles(dividend, divisor))
+                    << "dividend " << dividend << " divisor " << divisor;
+            }
+        }
+    }
+}
+
+TEST(CyclesTest, TestDivsEveryDivisor) {
+    for (auto divisor = 0u; divisor < 0x1'0000u; ++divisor) {
+        const uint32_t dividends[] = {
+            0u, 1u, -1u, divisor, -divisor, divisor * 0x5A5Au, -(divisor * 0x5A5Au),
+            divisor * 0x7FFFu, divisor * 0x8000u, -(divisor * 0x8000u), -(divisor * 0x8001u),
+            0x7FFF'FFFFu, 0x8000'0000u, divisor * 0x9E37'79B9u
+        };
+        for (const auto dividend : dividends) {
+            ASSERT_EQ(DivsCycles(dividend, divisor), MicrocodeDivsCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+            ASSERT_EQ(DivsTableCycles(dividend, divisor), MicrocodeDivsCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+        }
+    }
+}
+
+TEST(CyclesTest, TestDivsEveryQuotient) {
+    constexpr uint16_t divisors[] = { 1u, 5u, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFBu, 0xFFFFu };
+    for (const auto divisor : divisors) {
+        const auto absDivisor = (divisor & 0x8000u) ? 0x1'0000u - divisor : divisor;
+        for (auto quotient = 0u; quotient < 0x1'0000u; ++quotient) {
+            const auto dividend = quotient * absDivisor + absDivisor / 2u;
+            ASSERT_EQ(DivsCycles(dividend, divisor), MicrocodeDivsCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+            ASSERT_EQ(DivsTableCycles(dividend, divisor), MicrocodeDivsCycles(dividend, divisor))
+                << "dividend " << dividend << " divisor " << divisor;
+            ASSERT_EQ(DivsCycles(-dividend, divisor), MicrocodeDivsCycles(-dividend, divisor))
+                << "dividend " << -dividend << " divisor " << divisor;
+            ASSERT_EQ(DivsTableCycles(-dividend, divisor), MicrocodeDivsCycles(-dividend, divisor))
+                << "dividend " << -dividend << " divisor " << divisor;
+        }
+    }
+}
+
+TEST(CyclesTest, TestMulEveryMultiplier) {
+    for (auto multiplier = 0u; multiplier < 0x1'0000u; ++multiplier) {
+        for (const auto multiplicand : { 0u, 0x5A5Au, 0x8000u, 0xFFFFu }) {
+            MC68000 mulu;
+            mulu.rxdl = multiplicand;
+            mulu.rydl = multiplier;
+            auto muls = mulu;
+            mulu.ExecuteMulu();
+            muls.ExecuteMuls();
+            ASSERT_EQ(MuluCycles(multiplier), mulu.cycles) << "multiplier " << multiplier;
+            ASSERT_EQ(MulsCycles(multiplier), muls.cycles) << "multiplier " << multiplier;
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#include "68000_Cycles.h"
+#include "68000_Distribution.h"
+
+// The histograms are checked against the closed-form cycles of every dividend that doesn't overflow,
+// which is all of them but the 2^16 * divisor runs for small divisors
+
+namespace {
+
+constexpr auto ALL_DIVIDENDS = uint64_t{ 1 } << 32u;
+
+auto ExpectHistogramsEqual(const CycleHistogram& actual, const CycleHistogram& expected) -> void {
+    for (auto cycles = 0u; cycles < CYCLE_HISTOGRAM_SIZE; ++cycles) {
+        EXPECT_EQ(actual.counts[cycles], expected.counts[cycles]) << "cycles " << cycles;
+    }
+}
+
+}
+
+TEST(DistributionTest, TestDivuSmallDivisors) {
+    for (const uint16_t divisor : { 1u, 2u, 5u, 7u }) {
+        const auto divisions = uint64_t{ divisor } << 16u;
+        CycleHistogram expected;
+        for (auto dividend = uint64_t{}; dividend < divisions; ++dividend) {
+            expected.Add(DivuCycles(static_cast<uint32_t>(dividend), divisor), 1u);
+        }
+        expected.Add(DivuCycles(0xFFFF'FFFFu, divisor), ALL_DIVIDENDS - divisions);
+        ExpectHistogramsEqual(DivuCycleHistogram(divisor), expected);
+    }
+}
+
+TEST(DistributionTest, TestDivuQuotients) {
+    std::mt19937 random(18u);
+    for (const uint16_t divisor : { 0x7FFFu, 0x8000u, 0x8001u, 0xA5A5u, 0xFFFFu }) {
+        for (auto i = 0u; i < 24u; ++i) {
+            const auto quotient = static_cast<uint16_t>((i < 4u) ? 0x5555u * i : random());
+            CycleHistogram expected;
+            for (auto remainder = 0u; remainder < divisor; ++remainder) {
+                expected.Add(DivuCycles(static_cast<uint32_t>(quotient) * divisor + remainder, divisor), 1u);
+            }
+            CycleHistogram actual;
+            AddDivuQuotientCycles(actual, divisor, quotient);
+            ExpectHistogramsEqual(actual, expected);
+        }
+    }
+}
+
+TEST(DistributionTest, TestDivsSmallDivisors) {
+    for (const uint16_t divisor : { 1u, 3u, 0xFFFFu, 0xFFFDu }) {
+        const auto absDivisor = static_cast<uint16_t>((divisor & 0x8000u) ? 0u - divisor : divisor);
+        const auto divisions = uint64_t{ absDivisor } << 16u;
+        CycleHistogram expected;
+        for (auto dividend = uint64_t{}; dividend < divisions; ++dividend) {
+            expected.Add(DivsCycles(static_cast<uint32_t>(dividend), divisor), 1u);
+            if (dividend != 0u) {
+                expected.Add(DivsCycles(static_cast<uint32_t>(0u - dividend), divisor), 1u);
+            }
+        }
+        expected.Add(DivsCycles(0x7FFF'FFFFu, divisor), (ALL_DIVIDENDS >> 1u) - divisions);
+        expected.Add(DivsCycles(0x8000'0000u, divisor), (ALL_DIVIDENDS >> 1u) - divisions + 1u);
+        ExpectHistogramsEqual(DivsCycleHistogram(divisor), expected);
+    }
+}
+
+TEST(DistributionTest, TestEveryDividendCounted) {
+    for (const uint16_t divisor : { 0u, 1u, 0x7FFFu, 0x8000u, 0x8001u, 0xC000u, 0xFFFFu }) {
+        EXPECT_EQ(DivuCycleHistogram(divisor).Total(), ALL_DIVIDENDS);
+        EXPECT_EQ(DivsCycleHistogram(divisor).Total(), ALL_DIVIDENDS);
+    }
+}
+
+TEST(DistributionTest, TestBounds) {
+    EXPECT_EQ(DivuCycleHistogram(0u).Min(), 4u);
+    EXPECT_EQ(DivuCycleHistogram(0u).Max(), 4u);
+    EXPECT_EQ(DivuCycleHistogram(1u).Min(), 10u);
+    EXPECT_EQ(DivuCycleHistogram(1u).Max(), 136u);
+    EXPECT_EQ(DivuCycleHistogram(0xFFFFu).Max(), 136u);
+    EXPECT_EQ(DivsCycleHistogram(0x8000u).Min(), 18u); // The only overflow, -2^31
+    EXPECT_EQ(DivsCycleHistogram(1u).Max(), 156u);
+    EXPECT_DOUBLE_EQ(CycleHistogram{}.Mean(), 0.0);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#include "68000.h"
+#include "68000_Dividers.h"
+#include "68000_Distribution.h"
+
+// The what-if models must divide like the 68000 and take the cycles DividerCycles gives them
+
+namespace {
+
+auto Run(DividerModel model, DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) -> MC68000 {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    ExecuteDivision(model, instruction, mc68000);
+    return mc68000;
+}
+
+auto ExpectModelMatches(DividerModel model, DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) -> void {
+    const auto expected = Run(DividerModel::Restoring, instruction, dividend, divisor);
+    const auto actual = Run(model, instruction, dividend, divisor);
+    SCOPED_TRACE(testing::Message() << DividerModelName(model) << " " << std::hex << dividend << " / " << divisor);
+    EXPECT_EQ(actual.rxdh, expected.rxdh);
+    EXPECT_EQ(actual.rxdl, expected.rxdl);
+    EXPECT_EQ(actual.microword, expected.microword);
+    if (instruction == DivisionInstruction::Divu) {
+        EXPECT_EQ(actual.flags, expected.flags);
+    } else if ((actual.flags & FLAG_V) == 0u) {
+        EXPECT_EQ(actual.flags & (FLAG_N | FLAG_Z), expected.flags & (FLAG_N | FLAG_Z));
+    }
+    EXPECT_EQ(actual.cycles, DividerCycles(model, instruction, dividend, divisor));
+}
+
+}
+
+TEST(DividersTest, TestModelsMatchMicrocode) {
+    std::mt19937 random(21u);
+    for (auto i = 0u; i < 20'000u; ++i) {
+        const auto dividend = static_cast<uint32_t>(random()) >> (random() % 32u);
+        const auto divisor = static_cast<uint16_t>(random() >> (random() % 16u));
+        for (const auto model : DIVIDER_MODELS) {
+            ExpectModelMatches(model, DivisionInstruction::Divu, dividend, divisor);
+            ExpectModelMatches(model, DivisionInstruction::Divs, (i & 1u) ? 0u - dividend : dividend, divisor);
+        }
+    }
+}
+
+TEST(DividersTest, TestBoundaries) {
+    for (const auto dividend : { 0u, 1u, 0x7FFFu, 0x8000u, 0xFFFFu, 0x7FFF'0000u, 0x7FFF'FFFFu, 0x8000'0000u,
+                                 0xFFFE'0001u, 0xFFFF'0000u, 0xFFFF'FFFFu }) {
+        for (const uint16_t divisor : { 0u, 1u, 2u, 3u, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFEu, 0xFFFFu }) {
+            for (const auto model : DIVIDER_MODELS) {
+                ExpectModelMatches(model, DivisionInstruction::Divu, dividend, divisor);
+                ExpectModelMatches(model, DivisionInstruction::Divs, dividend, divisor);
+            }
+        }
+    }
+}
+
+TEST(DividersTest, TestCycles) {
+    // Quotient 5 is odd, quotient 0 needs the correction of the non-restoring remainder
+    EXPECT_EQ(DividerCycles(DividerModel::NonRestoring, DivisionInstruction::Divu, 29u, 5u), 76u);
+    EXPECT_EQ(DividerCycles(DividerModel::NonRestoring, DivisionInstruction::Divu, 0u, 1u), 78u);
+    EXPECT_EQ(DividerCycles(DividerModel::Srt4, DivisionInstruction::Divu, 29u, 5u), 36u);
+    EXPECT_EQ(DividerCycles(DividerModel::Srt4, DivisionInstruction::Divu, 0x0001'0000u, 1u), 10u); // Overflow
+    EXPECT_EQ(DividerCycles(DividerModel::Srt4, DivisionInstruction::Divs, 29u, 0u), 4u);
+}
+
+TEST(DividersTest, TestHistograms) {
+    for (const auto model : { DividerModel::NonRestoring, DividerModel::Srt4 }) {
+        for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+            for (const uint16_t divisor : { 0u, 1u, 3u, 0xFFFDu }) {
+                const auto absDivisor = static_cast<uint16_t>((instruction == DivisionInstruction::Divs && (divisor & 0x8000u)) ?
+                                                              0u - divisor : divisor);
+                const auto divisions = uint64_t{ absDivisor } << 16u;
+                if (divisions > (uint64_t{ 1 } << 20u)) {
+                    continue; // DIVU 0xFFFD, too many to count one by one
+                }
+                const auto total = uint64_t{ 1 } << 32u;
+                CycleHistogram expected;
+                if (divisor == 0u) {
+                    expected.Add(DividerCycles(model, instruction, 0u, 0u), total);
+                } else if (instruction == DivisionInstruction::Divu) {
+                    for (auto dividend = uint64_t{}; dividend < divisions; ++dividend) {
+                        expected.Add(DividerCycles(model, instruction, static_cast<uint32_t>(dividend), divisor), 1u);
+                    }
+                    expected.Add(DividerCycles(model, instruction, 0xFFFF'FFFFu, divisor), total - divisions);
+                } else {
+                    for (auto dividend = uint64_t{}; dividend < divisions; ++dividend) {
+                        expected.Add(DividerCycles(model, instruction, static_cast<uint32_t>(dividend), divisor), 1u);
+                        if (dividend != 0u) {
+                            expected.Add(DividerCycles(model, instruction, static_cast<uint32_t>(0u - dividend), divisor), 1u);
+                        }
+                    }
+                    expected.Add(DividerCycles(model, instruction, 0x7FFF'FFFFu, divisor), total / 2u - divisions);
+                    expected.Add(DividerCycles(model, instruction, 0x8000'0000u, divisor), total / 2u - divisions + 1u);
+                }
+                EXPECT_EQ(CycleHistogramOf(model, instruction, divisor).counts, expected.counts)
+                    << DividerModelName(model) << " divisor " << divisor;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Division_C.h"
+
+// The C interface through the shared library, checked against the microcode
+
+namespace {
+
+auto Microcode(bool divs, uint32_t dividend, uint16_t divisor) -> MC68000 {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    divs ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+    return mc68000;
+}
+
+}
+
+TEST(DivisionCTest, TestSingle) {
+    EXPECT_EQ(m68k_abi_version(), static_cast<uint32_t>(M68K_DIVISION_ABI_VERSION));
+    for (const auto divs : { false, true }) {
+        for (const auto dividend : { 29u, 0xFFFF'FFE3u, 0x0004'3210u, 0x8000'0000u }) {
+            for (const uint16_t divisor : { 0u, 1u, 5u, 0x8000u, 0xFFFBu }) {
+                m68k_division_result result{};
+                const auto status = divs ? m68k_divs(dividend, divisor, &result) : m68k_divu(dividend, divisor, &result);
+                ASSERT_EQ(status, M68K_OK);
+                const auto expected = Microcode(divs, dividend, divisor);
+                EXPECT_EQ(result.remainder, expected.rxdh);
+                EXPECT_EQ(result.quotient, expected.rxdl);
+                EXPECT_EQ(result.flags, expected.flags);
+                EXPECT_EQ(result.reserved, 0u);
+                EXPECT_EQ(result.cycles, expected.cycles);
+            }
+        }
+    }
+    EXPECT_EQ(m68k_divu(29u, 5u, nullptr), M68K_INVALID_ARGUMENT);
+}
+
+TEST(DivisionCTest, TestBatch) {
+    constexpr auto count = 1'003u; // Not a multiple of the vector width
+    std::mt19937 random(20u);
+    std::vector<uint32_t> dividends(count);
+    std::vector<uint16_t> divisors(count);
+    for (auto i = 0u; i < count; ++i) {
+        dividends[i] = static_cast<uint32_t>(random());
+        divisors[i] = static_cast<uint16_t>(random() >> (random() % 16u));
+    }
+    for (const auto divs : { false, true }) {
+        std::vector<uint16_t> remainders(count);
+        std::vector<uint16_t> quotients(count);
+        std::vector<uint16_t> flags(count);
+        std::vector<uint32_t> cycles(count);
+        const auto batch = divs ? m68k_divs_batch : m68k_divu_batch;
+        ASSERT_EQ(batch(dividends.data(), divisors.data(), count, remainders.data(), quotients.data(), flags.data(),
+                        cycles.data()), M68K_OK);
+        for (auto i = 0u; i < count; ++i) {
+            const auto expected = Microcode(divs, dividends[i], divisors[i]);
+            EXPECT_EQ(remainders[i], expected.rxdh);
+            EXPECT_EQ(quotients[i], expected.rxdl);
+            EXPECT_EQ(flags[i], expected.flags);
+            EXPECT_EQ(cycles[i], expected.cycles);
+        }
+    }
+}
+
+TEST(DivisionCTest, TestBatchArguments) {
+    uint32_t dividend = 29u;
+    uint16_t divisor = 5u;
+    uint16_t out[3]{};
+    uint32_t cycles{};
+    EXPECT_EQ(m68k_divu_batch(nullptr, nullptr, 0u, nullptr, nullptr, nullptr, nullptr), M68K_OK);
+    EXPECT_EQ(m68k_divu_batch(&dividend, &divisor, 1u, &out[0], &out[1], nullptr, &cycles), M68K_INVALID_ARGUMENT);
+    EXPECT_EQ(m68k_divs_batch(&dividend, nullptr, 1u, &out[0], &out[1], &out[2], &cycles), M68K_INVALID_ARGUMENT);
+    EXPECT_EQ(m68k_divu_batch(&dividend, &divisor, 1u, &out[0], &out[1], &out[2], &cycles), M68K_OK);
+    EXPECT_EQ(out[0], 4u);
+    EXPECT_EQ(out[1], 5u);
+}
+
+TEST(DivisionCTest, TestInstructionCycles) {
+    EXPECT_EQ(m68k_instruction_cycles(0x80C1u, 0x0001'0000u, 1u), 10u); // DIVU D1,D0 overflow
+    EXPECT_EQ(m68k_instruction_cycles(0x4E71u, 0u, 0u), 0u);
+}
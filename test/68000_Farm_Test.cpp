@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Farm.h"
+
+struct FarmBuffers {
+    std::vector<uint32_t> dividends;
+    std::vector<uint16_t> divisors;
+    std::vector<uint16_t> remainders;
+    std::vector<uint16_t> quotients;
+    std::vector<uint16_t> flags;
+    std::vector<uint32_t> cycles;
+
+    explicit FarmBuffers(std::size_t size) :
+        dividends(size), divisors(size), remainders(size), quotients(size), flags(size), cycles(size) {
+        auto random = 0x1234'5678u;
+        for (auto i = 0u; i < size; ++i) {
+            random = random * 1664525u + 1013904223u;
+            dividends[i] = random;
+            random = random * 1664525u + 1013904223u;
+            // Every fourth division overflows so the slices take different times
+            divisors[i] = (i % 4u == 0u) ? 1u : random >> 16u;
+        }
+    }
+
+    auto Operands() const -> DivisionOperands { return { dividends, divisors }; }
+    auto Results() -> DivisionResults { return { remainders, quotients, flags, cycles }; }
+
+    auto Check(bool isSigned) const -> void {
+        for (auto i = 0u; i < dividends.size(); ++i) {
+            auto mc68000 = LoadDivision(dividends[i], divisors[i]);
+            isSigned ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+            ASSERT_EQ(remainders[i], mc68000.rxdh) << "index " << i;
+            ASSERT_EQ(quotients[i], mc68000.rxdl) << "index " << i;
+            ASSERT_EQ(flags[i], mc68000.flags) << "index " << i;
+            ASSERT_EQ(cycles[i], mc68000.cycles) << "index " << i;
+        }
+    }
+};
+
+TEST(FarmTest, TestFutures) {
+    FarmBuffers divu(100'000u);
+    FarmBuffers divs(33'333u);
+    DivisionFarm farm(4u, 1000u);
+    auto divuDone = farm.Submit(DivisionInstruction::Divu, divu.Operands(), divu.Results());
+    auto divsDone = farm.Submit(DivisionInstruction::Divs, divs.Operands(), divs.Results());
+    divuDone.get();
+    divsDone.get();
+    divu.Check(false);
+    divs.Check(true);
+}
+
+TEST(FarmTest, TestCallbacksAndStatistics) {
+    std::vector<FarmBuffers> jobs(8u, FarmBuffers(5000u));
+    std::atomic<unsigned> completed{};
+    auto divisions = uint64_t{};
+    {
+        DivisionFarm farm(3u, 256u);
+        for (auto& job : jobs) {
+            farm.Submit(DivisionInstruction::Divu, job.Operands(), job.Results(), [&] { ++completed; });
+        }
+        farm.Wait();
+        EXPECT_EQ(completed.load(), jobs.size());
+        for (const auto& statistics : farm.Statistics()) {
+            divisions += statistics.divisions;
+        }
+        ASSERT_EQ(farm.Statistics().size(), 3u);
+    }
+    EXPECT_EQ(divisions, 8u * 5000u);
+    for (const auto& job : jobs) {
+        job.Check(false);
+    }
+}
+
+TEST(FarmTest, TestEmptyJob) {
+    DivisionFarm farm(2u);
+    FarmBuffers empty(0u);
+    auto done = farm.Submit(DivisionInstruction::Divs, empty.Operands(), empty.Results());
+    done.get();
+    farm.Wait();
+}
+
+TEST(FarmTest, TestShortSpans) {
+    DivisionFarm farm(2u);
+    FarmBuffers buffers(100u);
+    buffers.cycles.resize(99u);
+    EXPECT_THROW(farm.Submit(DivisionInstruction::Divu, buffers.Operands(), buffers.Results()), std::invalid_argument);
+    EXPECT_THROW(farm.Submit(DivisionInstruction::Divs, buffers.Operands(), buffers.Results(), [] {}), std::invalid_argument);
+    farm.Wait();
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#include "68000.h"
+#include "68000_Batch.h"
+#include "68000_Dividers.h"
+
+// The flags of the ALU operations, eager or with M68K_LAZY_FLAGS, against the 68000 definitions.
+// Each bit is also read on its own, as the branches of the microcode do
+
+namespace {
+
+constexpr auto ALL_FLAGS = FLAG_X | FLAG_N | FLAG_Z | FLAG_V | FLAG_C;
+
+auto SubFlags(uint16_t dst, uint16_t src) -> uint16_t {
+    const auto result = static_cast<uint16_t>(dst - src);
+    const auto borrow = dst < src;
+    const auto overflow = static_cast<int32_t>(static_cast<int16_t>(dst)) - static_cast<int16_t>(src) !=
+                          static_cast<int16_t>(result);
+    return (borrow ? FLAG_X | FLAG_C : 0u) | ((result & 0x8000u) ? FLAG_N : 0u) | ((result == 0u) ? FLAG_Z : 0u) |
+           (overflow ? FLAG_V : 0u);
+}
+
+auto ExpectBits(const ConditionCodes& flags, uint16_t expected) -> void {
+    EXPECT_EQ(static_cast<uint16_t>(flags), expected);
+    for (const auto bit : { FLAG_X, FLAG_N, FLAG_Z, FLAG_V, FLAG_C }) {
+        EXPECT_EQ(flags & bit, expected & bit) << "bit " << bit;
+    }
+}
+
+}
+
+TEST(FlagsTest, TestSub) {
+    std::mt19937 random(23u);
+    for (auto i = 0u; i < 100'000u; ++i) {
+        const auto dst = static_cast<uint16_t>((i < 0x1'0000u) ? i : random());
+        const auto src = static_cast<uint16_t>(random() >> (random() % 16u));
+        MC68000 mc68000;
+        mc68000.flags = ALL_FLAGS;
+        ExpectBits(mc68000.AluOp_SUB(dst, src), ALL_FLAGS); // The flags from before
+        ExpectBits(mc68000.Flags(), SubFlags(dst, src));
+        mc68000.SyncFlags();
+        EXPECT_EQ(mc68000.flags, SubFlags(dst, src));
+    }
+}
+
+TEST(FlagsTest, TestAndKeepsX) {
+    for (const uint16_t value : { 0x0000u, 0x0001u, 0x7FFFu, 0x8000u, 0xFFFFu }) {
+        // X from a pending SUB, 0 - 1 borrows and 1 - 0 doesn't
+        for (const uint16_t dst : { 0u, 1u }) {
+            MC68000 mc68000;
+            mc68000.AluOp_SUB(dst, 1u - dst);
+            const auto x = (dst == 0u) ? FLAG_X : 0u;
+            ExpectBits(mc68000.AluOp_AND(value, 0xFFFFu), SubFlags(dst, 1u - dst));
+            ExpectBits(mc68000.Flags(), x | ((value & 0x8000u) ? FLAG_N : 0u) | ((value == 0u) ? FLAG_Z : 0u));
+            // SUBX subtracts X, the shift leaves the flags alone
+            mc68000.AluOp_SUBX(0u, value);
+            EXPECT_EQ(mc68000.alu, static_cast<uint16_t>(0u - value - (x ? 1u : 0u)));
+            const auto before = static_cast<uint16_t>(mc68000.Flags());
+            ExpectBits(mc68000.AluOp_SLAAx(1u), before);
+            mc68000.SyncFlags();
+            EXPECT_EQ(mc68000.flags, before);
+        }
+    }
+}
+
+TEST(FlagsTest, TestWriteAfterSync) {
+    MC68000 mc68000;
+    mc68000.AluOp_AND(0x8000u, 0xFFFFu);
+    mc68000.SyncFlags();
+    mc68000.flags &= ~FLAG_N;
+    EXPECT_EQ(static_cast<uint16_t>(mc68000.Flags()), 0u);
+    EXPECT_EQ(mc68000.Flags() & FLAG_N, 0u);
+}
+
+// Every execute function leaves flags up to date, a pending operation would be read back through Flags()
+TEST(FlagsTest, TestExecuteLeavesFlagsSynced) {
+    const auto expectSynced = [](const MC68000& mc68000, const char* name) {
+        EXPECT_EQ(static_cast<uint16_t>(mc68000.Flags()), mc68000.flags)
+            << name << " " << std::hex << mc68000.rxdh << ":" << mc68000.rxdl << " / " << mc68000.rydl;
+    };
+    for (const uint32_t dividend : { 0u, 29u, 0x0000'8000u, 0x0001'0000u, 0x7FFF'FFFFu, 0x8000'0000u, 0xFFFF'8000u }) {
+        for (const uint16_t divisor : { 0u, 1u, 5u, 0x8000u, 0xFFFFu }) {
+            const auto start = LoadDivision(dividend, divisor);
+            for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+                const auto isSigned = instruction == DivisionInstruction::Divs;
+                auto microcode = start;
+                isSigned ? microcode.ExecuteDivs() : microcode.ExecuteDivu();
+                expectSynced(microcode, "microcode");
+                auto fused = start;
+                isSigned ? fused.ExecuteDivsFused() : fused.ExecuteDivuFused();
+                expectSynced(fused, "fused");
+                auto native = start;
+                isSigned ? native.ExecuteDivsNative() : native.ExecuteDivuNative();
+                expectSynced(native, "native");
+                for (const auto model : DIVIDER_MODELS) {
+                    auto modelled = start;
+                    ExecuteDivision(model, instruction, modelled);
+                    expectSynced(modelled, DividerModelName(model));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "68000.h"
+#include "68000_Coverage_Vectors.h"
+#include "68000_Profile.h"
+#include "68000_State.h"
+#include "68000_Trace.h"
+
+// The unrolled main loops must leave every register as the microwords do and trace the same records
+
+namespace {
+
+auto ExpectFusedMatches(bool divs, const MC68000& start) -> void {
+    SCOPED_TRACE(testing::Message() << (divs ? "DIVS " : "DIVU ") << std::hex << start.rxdh << ":" << start.rxdl
+                                    << " / " << start.rydl);
+    auto expected = start;
+    auto actual = start;
+    divs ? expected.ExecuteDivs() : expected.ExecuteDivu();
+    divs ? actual.ExecuteDivsFused() : actual.ExecuteDivuFused();
+    ExpectSameState(actual, expected);
+}
+
+}
+
+TEST(FusedTest, TestCoverageVectors) {
+    for (const auto& [instruction, dividend, divisor] : COVERAGE_VECTORS) {
+        ExpectFusedMatches(instruction == DivisionInstruction::Divs, LoadDivision(dividend, divisor));
+    }
+}
+
+TEST(FusedTest, TestRandom) {
+    std::mt19937 random(24u);
+    for (auto i = 0u; i < 100'000u; ++i) {
+        auto start = LoadDivision(static_cast<uint32_t>(random()) >> (random() % 32u),
+                                  static_cast<uint16_t>(random() >> (random() % 16u)));
+        start.pc = random();
+        start.au = random();
+        start.flags = random() & 0x1Fu;
+        start.cycles = random() % 1000u;
+        ExpectFusedMatches((i & 1u) != 0u, start);
+    }
+}
+
+TEST(FusedTest, TestTraceRecords) {
+    for (const auto divs : { false, true }) {
+        for (const auto& [dividend, divisor] : { std::pair{ 29u, 5u }, std::pair{ 0xFFFF'FFE3u, 5u },
+                                                 std::pair{ 0x8000'FFFFu, 0x8001u } }) {
+            RingTraceSink expected(64u);
+            RingTraceSink actual(64u);
+            auto mc68000 = LoadDivision(dividend, static_cast<uint16_t>(divisor));
+            divs ? mc68000.ExecuteDivs(expected) : mc68000.ExecuteDivu(expected);
+            mc68000 = LoadDivision(dividend, static_cast<uint16_t>(divisor));
+            divs ? mc68000.ExecuteDivsFused(actual) : mc68000.ExecuteDivuFused(actual);
+            ASSERT_EQ(actual.Size(), expected.Size());
+            for (auto i = std::size_t{}; i < expected.Size(); ++i) {
+                EXPECT_EQ(actual[i].microword, expected[i].microword) << i;
+                EXPECT_EQ(actual[i].au, expected[i].au) << i;
+                EXPECT_EQ(actual[i].alu, expected[i].alu) << i;
+                EXPECT_EQ(actual[i].alue, expected[i].alue) << i;
+                EXPECT_EQ(actual[i].alub, expected[i].alub) << i;
+                EXPECT_EQ(actual[i].rxdh, expected[i].rxdh) << i;
+            }
+        }
+    }
+}
+
+TEST(FusedTest, TestStepSinkSeesEveryMicroword) {
+    ProfileTraceSink sink;
+    auto mc68000 = LoadDivision(29u, 5u);
+    mc68000.ExecuteDivuFused(sink);
+    EXPECT_EQ(sink.branches[DVUMB][DVUME], 14u);
+    EXPECT_EQ(sink.executions[DVUMB], 15u);
+    EXPECT_EQ(sink.executions[A1], 1u);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstdint>
+
+#include "68000.h"
+#include "68000_Profile.h"
+
+// The products are checked against the host's multiplication and the timing against the
+// documented 38 + 2n cycles, n being the number of 1 bits of the multiplier for MULU and the
+// number of 01 and 10 pairs in the multiplier with a 0 appended for MULS.
+
+constexpr uint16_t MUL_TEST_MULTIPLICANDS[] = {
+    0u, 1u, 2u, 0x5A5Au, 0x7FFFu, 0x8000u, 0x8001u, 0xA5A5u, 0xFFFEu, 0xFFFFu,
+};
+
+auto ExpectedFlags(uint32_t product, uint16_t before) -> uint16_t {
+    return (before & FLAG_X) | ((product & 0x8000'0000u) ? FLAG_N : 0u) | ((product == 0u) ? FLAG_Z : 0u);
+}
+
+TEST(MulTest, TestMuluEveryMultiplier) {
+    for (auto multiplier = 0u; multiplier < 0x1'0000u; ++multiplier) {
+        for (const auto multiplicand : MUL_TEST_MULTIPLICANDS) {
+            MC68000 mc68000;
+            mc68000.rxdh = 0x1234u;
+            mc68000.rxdl = multiplicand;
+            mc68000.rydl = multiplier;
+            mc68000.flags = (multiplier & 1u) ? (FLAG_X | FLAG_V | FLAG_C) : 0u;
+            const auto before = mc68000.flags;
+            mc68000.ExecuteMulu();
+            const auto product = multiplicand * multiplier;
+            ASSERT_EQ(static_cast<uint32_t>(mc68000.rxdh) << 16u | mc68000.rxdl, product)
+                << multiplicand << " * " << multiplier;
+            ASSERT_EQ(mc68000.rydl, multiplier);
+            ASSERT_EQ(mc68000.flags, ExpectedFlags(product, before)) << multiplicand << " * " << multiplier;
+            ASSERT_EQ(mc68000.cycles, 38u + 2u * static_cast<uint32_t>(std::popcount(multiplier)));
+            ASSERT_EQ(mc68000.microword, A1);
+        }
+    }
+}
+
+TEST(MulTest, TestMulsEveryMultiplier) {
+    for (auto multiplier = 0u; multiplier < 0x1'0000u; ++multiplier) {
+        for (const auto multiplicand : MUL_TEST_MULTIPLICANDS) {
+            MC68000 mc68000;
+            mc68000.rxdl = multiplicand;
+            mc68000.rydl = multiplier;
+            mc68000.flags = (multiplier & 1u) ? (FLAG_X | FLAG_V | FLAG_C) : 0u;
+            const auto before = mc68000.flags;
+            mc68000.ExecuteMuls();
+            const auto product = static_cast<uint32_t>(static_cast<int16_t>(multiplicand) * static_cast<int16_t>(multiplier));
+            ASSERT_EQ(static_cast<uint32_t>(mc68000.rxdh) << 16u | mc68000.rxdl, product)
+                << static_cast<int16_t>(multiplicand) << " * " << static_cast<int16_t>(multiplier);
+            ASSERT_EQ(mc68000.flags, ExpectedFlags(product, before));
+            auto pairs = 0u;
+            for (auto previous = 0u, bit = 0u; bit < 16u; previous = (multiplier >> bit) & 1u, ++bit) {
+                pairs += ((multiplier >> bit) & 1u) != previous;
+            }
+            ASSERT_EQ(mc68000.cycles, 38u + 2u * pairs) << "multiplier " << multiplier;
+        }
+    }
+}
+
+TEST(MulTest, TestProfile) {
+    // 0x00F0 has four 1 bits, MULU adds four times and MULS adds once and subtracts once
+    MC68000 mc68000;
+    ProfileTraceSink mulu;
+    mc68000.rxdl = 3u;
+    mc68000.rydl = 0x00F0u;
+    mc68000.ExecuteMulu(mulu);
+    EXPECT_EQ(mulu.executions[MULM4], 16u);
+    EXPECT_EQ(mulu.executions[MULM3], 4u);
+    EXPECT_EQ(mulu.executions[MULM5], 0u);
+    EXPECT_EQ(mulu.branches[MULM4][MULM6], 1u);
+
+    ProfileTraceSink muls;
+    mc68000 = {};
+    mc68000.rxdl = 3u;
+    mc68000.rydl = 0x00F0u;
+    mc68000.ExecuteMuls(muls);
+    EXPECT_EQ(muls.executions[MULM3], 1u);
+    EXPECT_EQ(muls.executions[MULM5], 1u);
+    EXPECT_EQ(static_cast<uint32_t>(mc68000.rxdh) << 16u | mc68000.rxdl, 3u * 0xF0u);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#include "68000.h"
+#include "68000_Cycles.h"
+#include "68000_Native.h"
+
+constexpr uint32_t NATIVE_TEST_DIVIDENDS[] = {
+    0u, 29u, 0x0000'7FFFu, 0x0000'8000u, 0x0004'3210u, 0x5A5A'0008u, 0x7FFF'0000u, 0x7FFF'FFFFu,
+    0x8000'0000u, 0x8000'0001u, 0xA5A5'CCDDu, 0xFFFF'0000u, 0xFFFF'7FFFu, 0xFFFF'8000u, 0xFFFF'FFE3u, 0xFFFF'FFFFu,
+};
+
+constexpr uint16_t NATIVE_TEST_DIVISORS[] = {
+    0u, 1u, 2u, 5u, 0x5A5Bu, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFBu, 0xFFFFu,
+};
+
+namespace {
+
+auto CountingDivision(uint64_t& mismatches) -> DualModeDivision {
+    DualModeDivision division(DivisionMode::Native, 1u);
+    division.SetMismatchHandler([&](DivisionInstruction, const MC68000&, const MC68000&, const MC68000&) { ++mismatches; });
+    return division;
+}
+
+}
+
+TEST(NativeTest, TestMatchesMicrocode) {
+    uint64_t mismatches{};
+    auto division = CountingDivision(mismatches);
+    for (const auto dividend : NATIVE_TEST_DIVIDENDS) {
+        for (const auto divisor : NATIVE_TEST_DIVISORS) {
+            for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+                auto mc68000 = LoadDivision(dividend, divisor);
+                division.Execute(instruction, mc68000);
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_EQ(division.Statistics().verified, 2u * std::size(NATIVE_TEST_DIVIDENDS) * std::size(NATIVE_TEST_DIVISORS));
+}
+
+TEST(NativeTest, TestRandomStates) {
+    // Flags and cycles left by earlier instructions
+    uint64_t mismatches{};
+    auto division = CountingDivision(mismatches);
+    std::mt19937 random(15u);
+    for (auto i = 0u; i < 200'000u; ++i) {
+        MC68000 mc68000;
+        mc68000.rxdh = static_cast<uint16_t>(random());
+        mc68000.rxdl = static_cast<uint16_t>(random());
+        mc68000.rydl = static_cast<uint16_t>(random() >> (random() % 16u));
+        mc68000.flags = random() & 0x1Fu;
+        mc68000.cycles = random() % 1000u;
+        (i & 1u) ? division.Divs(mc68000) : division.Divu(mc68000);
+    }
+    EXPECT_EQ(mismatches, 0u);
+}
+
+TEST(NativeTest, TestSampling) {
+    uint64_t mismatches{};
+    auto division = CountingDivision(mismatches);
+    division.SetSampleInterval(4u);
+    MC68000 mc68000;
+    for (auto i = 0u; i < 100u; ++i) {
+        mc68000.rxdh = 0u;
+        mc68000.rxdl = 29u;
+        mc68000.rydl = 5u;
+        division.Divu(mc68000);
+    }
+    EXPECT_EQ(division.Statistics().native, 100u);
+    EXPECT_EQ(division.Statistics().verified, 25u);
+    EXPECT_EQ(mc68000.cycles, 100u * DivuCycles(29u, 5u));
+
+    division.SetSampleInterval(0u);
+    division.Divu(mc68000);
+    EXPECT_EQ(division.Statistics().verified, 25u);
+
+    division.SetMode(DivisionMode::Microcode);
+    division.Divu(mc68000);
+    EXPECT_EQ(division.Statistics().native, 101u);
+    EXPECT_EQ(mismatches, 0u);
+}
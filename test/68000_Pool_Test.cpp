@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+
+#include "68000.h"
+#include "68000_Pool.h"
+
+constexpr uint32_t POOL_TEST_DIVIDENDS[] = {
+    29u, 0u, 0x0004'3210u, 0x5A5A'0008u, 0xA5A5'CCDDu, 0x7FFF'FFFFu, 0x8000'0000u, 0xFFFF'FFE3u,
+};
+
+constexpr uint16_t POOL_TEST_DIVISORS[] = {
+    5u, 0u, 1u, 0x5A5Bu, 0x7FFFu, 0x8000u, 0xFFFBu,
+};
+
+TEST(PoolTest, TestMatchesSingleContexts) {
+    MC68000Pool pool;
+    pool.Resize(2u * std::size(POOL_TEST_DIVIDENDS) * std::size(POOL_TEST_DIVISORS));
+    auto i = 0u;
+    for (const auto dividend : POOL_TEST_DIVIDENDS) {
+        for (const auto divisor : POOL_TEST_DIVISORS) {
+            pool.SetDivu(i++, dividend, divisor);
+            pool.SetDivs(i++, dividend, divisor);
+        }
+    }
+    pool.Execute();
+
+    i = 0u;
+    for (const auto dividend : POOL_TEST_DIVIDENDS) {
+        for (const auto divisor : POOL_TEST_DIVISORS) {
+            for (const auto isSigned : { false, true }) {
+                auto expected = LoadDivision(dividend, divisor);
+                isSigned ? expected.ExecuteDivs() : expected.ExecuteDivu();
+                const auto actual = pool.Load(i++);
+                SCOPED_TRACE(testing::Message() << "dividend " << dividend << " divisor " << divisor << " signed " << isSigned);
+                EXPECT_EQ(actual.microword, expected.microword);
+                EXPECT_EQ(actual.rxdh, expected.rxdh);
+                EXPECT_EQ(actual.rxdl, expected.rxdl);
+                EXPECT_EQ(actual.flags, expected.flags);
+                EXPECT_EQ(actual.alu, expected.alu);
+                EXPECT_EQ(actual.au, expected.au);
+                EXPECT_EQ(actual.cycles, expected.cycles);
+            }
+        }
+    }
+}
+
+TEST(PoolTest, TestExecuteRangeLeavesOthers) {
+    MC68000Pool pool(4u);
+    for (auto i = 0u; i < pool.Size(); ++i) {
+        pool.SetDivu(i, 29u, 5u);
+    }
+    pool.Execute(1u, 2u);
+    EXPECT_EQ(pool.microword[0], DVUR1);
+    EXPECT_EQ(pool.microword[1], A1);
+    EXPECT_EQ(pool.microword[2], A1);
+    EXPECT_EQ(pool.microword[3], DVUR1);
+    EXPECT_EQ(pool.rxdl[1], 5u);
+    EXPECT_EQ(pool.rxdh[2], 4u);
+    EXPECT_EQ(pool.cycles[3], 0u);
+
+    // Contexts that have left the microcode aren't run again
+    pool.Execute();
+    EXPECT_EQ(pool.cycles[1], pool.cycles[0]);
+}
+
+TEST(PoolTest, TestUnsetContextsLeft) {
+    MC68000Pool pool(3u);
+    pool.SetDivu(1u, 29u, 5u);
+    pool.Execute();
+    for (const auto i : { 0u, 2u }) {
+        EXPECT_EQ(pool.microword[i], A1);
+        EXPECT_EQ(pool.cycles[i], 0u);
+        EXPECT_EQ(pool.rxdh[i], 0u);
+    }
+    EXPECT_EQ(pool.rxdl[1], 5u);
+
+    // Grown contexts too
+    pool.Resize(5u);
+    pool.SetDivs(4u, 29u, 5u);
+    pool.Execute();
+    EXPECT_EQ(pool.microword[3], A1);
+    EXPECT_EQ(pool.cycles[3], 0u);
+    EXPECT_EQ(pool.rxdl[4], 5u);
+}
+
+TEST(PoolTest, TestResumesStoppedContexts) {
+    MC68000Pool pool(2u * std::size(POOL_TEST_DIVIDENDS) * std::size(POOL_TEST_DIVISORS));
+    auto i = 0u;
+    for (const auto dividend : POOL_TEST_DIVIDENDS) {
+        for (const auto divisor : POOL_TEST_DIVISORS) {
+            pool.SetDivu(i, dividend, divisor);
+            auto divu = pool.Load(i);
+            divu.RunDivu(20u);
+            pool.Store(i++, divu);
+            pool.SetDivs(i, dividend, divisor);
+            auto divs = pool.Load(i);
+            divs.RunDivs(30u);
+            pool.Store(i++, divs);
+        }
+    }
+    pool.Execute();
+
+    i = 0u;
+    for (const auto dividend : POOL_TEST_DIVIDENDS) {
+        for (const auto divisor : POOL_TEST_DIVISORS) {
+            for (const auto isSigned : { false, true }) {
+                auto mc68000 = LoadDivision(dividend, divisor);
+                isSigned ? mc68000.ExecuteDivs() : mc68000.ExecuteDivu();
+                EXPECT_EQ(pool.microword[i], mc68000.microword) << i;
+                EXPECT_EQ(pool.rxdh[i], mc68000.rxdh) << i;
+                EXPECT_EQ(pool.rxdl[i], mc68000.rxdl) << i;
+                EXPECT_EQ(pool.flags[i], mc68000.flags) << i;
+                EXPECT_EQ(pool.cycles[i], mc68000.cycles) << i;
+                ++i;
+            }
+        }
+    }
+}
+
+TEST(PoolTest, TestExecutePastTheEnd) {
+    MC68000Pool pool(4u);
+    pool.SetDivu(3u, 29u, 5u);
+    EXPECT_THROW(pool.Execute(3u, 2u), std::invalid_argument);
+    EXPECT_THROW(pool.Execute(5u, 0u), std::invalid_argument);
+    EXPECT_EQ(pool.microword[3], DVUR1);
+    pool.Execute(4u, 0u);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+
+#include "68000.h"
+#include "68000_Profile.h"
+
+// 29 / 5 has quotient 0b101, so of the quotient bits 15 to 1 fourteen are 0 and one is 1
+
+TEST(ProfileTest, TestDivuBranches) {
+    MC68000 mc68000;
+    ProfileTraceSink sink;
+    mc68000.rxdh = 0u;
+    mc68000.rxdl = 29u;
+    mc68000.rydl = 5u;
+    mc68000.ExecuteDivu(sink);
+    EXPECT_EQ(sink.executions[DVUR1], 1u);
+    EXPECT_EQ(sink.executions[A1], 1u);
+    EXPECT_EQ(sink.branches[DVUR1][DVUM2], 1u);
+    EXPECT_EQ(sink.branches[DVUMB][DVUME], 14u);
+    EXPECT_EQ(sink.branches[DVUMB][DVUM6], 1u);
+    EXPECT_EQ(sink.executions[DVUMB], 15u);
+}
+
+TEST(ProfileTest, TestDivsBranches) {
+    MC68000 mc68000;
+    ProfileTraceSink sink;
+    mc68000.rxdh = 0xFFFFu;
+    mc68000.rxdl = static_cast<uint16_t>(-29);
+    mc68000.rydl = 5u;
+    mc68000.ExecuteDivs(sink);
+    EXPECT_EQ(sink.executions[DVS01], 1u);
+    EXPECT_EQ(sink.executions[A1], 1u);
+    EXPECT_EQ(sink.branches[DVS0D][DVS0F], 14u);
+    EXPECT_EQ(sink.branches[DVS0D][DVS0A], 1u);
+}
+
+TEST(ProfileTest, TestDivideByZeroExits) {
+    MC68000 mc68000;
+    ProfileTraceSink sink;
+    mc68000.rxdl = 29u;
+    mc68000.ExecuteDivu(sink);
+    EXPECT_EQ(sink.branches[DVUM2][TRAP0], 1u);
+    EXPECT_EQ(sink.executions[TRAP0], 1u);
+    EXPECT_EQ(sink.executions[A1], 0u);
+}
+
+TEST(ProfileTest, TestAddAndExport) {
+    ProfileTraceSink total;
+    for (auto i = 0u; i < 3u; ++i) {
+        MC68000 mc68000;
+        ProfileTraceSink sink;
+        mc68000.rxdl = 29u;
+        mc68000.rydl = 5u;
+        mc68000.ExecuteDivu(sink);
+        total += sink;
+    }
+    EXPECT_EQ(total.executions[A1], 3u);
+    EXPECT_EQ(total.branches[DVUMB][DVUME], 3u * 14u);
+
+    std::ostringstream csv;
+    total.WriteCsv(csv);
+    EXPECT_NE(csv.str().find("kind,from,to,count\n"), std::string::npos);
+    EXPECT_NE(csv.str().find("microword,A1,,3\n"), std::string::npos);
+    EXPECT_NE(csv.str().find("branch,DVUMB,DVUME,42\n"), std::string::npos);
+
+    std::ostringstream json;
+    total.WriteJson(json);
+    EXPECT_NE(json.str().find("\"A1\":3"), std::string::npos);
+    EXPECT_NE(json.str().find("{\"from\":\"DVUMB\",\"to\":\"DVUME\",\"count\":42}"), std::string::npos);
+}
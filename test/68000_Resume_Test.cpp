@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#include "68000.h"
+#include "68000_Profile.h"
+#include "68000_State.h"
+
+// Divisions run in slices of a few cycles must end in the same state as ExecuteDivu and ExecuteDivs
+
+TEST(ResumeTest, TestSlicesMatchExecute) {
+    std::mt19937 random(19u);
+    for (auto i = 0u; i < 2'000u; ++i) {
+        MC68000 start;
+        start.rxdh = static_cast<uint16_t>(random() >> (random() % 16u));
+        start.rxdl = static_cast<uint16_t>(random());
+        start.rydl = static_cast<uint16_t>(random() >> (random() % 16u));
+        start.cycles = random() % 1000u;
+        const auto divs = (i & 1u) != 0u;
+        const auto maxCycles = 1u + i % 12u;
+
+        auto expected = start;
+        divs ? expected.ExecuteDivs() : expected.ExecuteDivu();
+
+        auto actual = start;
+        actual.microword = divs ? DVS01 : DVUR1;
+        auto calls = 0u;
+        while (true) {
+            const auto before = actual.cycles;
+            const auto done = divs ? actual.RunDivs(maxCycles) : actual.RunDivu(maxCycles);
+            ++calls;
+            EXPECT_LE(actual.cycles - before, maxCycles + 1u); // Whole microwords of 2 cycles
+            if (done) {
+                break;
+            }
+            ASSERT_LT(calls, 200u);
+        }
+        ExpectSameState(actual, expected);
+        const auto instructionCycles = expected.cycles - start.cycles;
+        EXPECT_EQ(calls, (maxCycles & 1u) ?
+                         (instructionCycles + maxCycles) / (maxCycles + 1u) : (instructionCycles + maxCycles - 1u) / maxCycles)
+            << "instruction cycles " << instructionCycles << ", slices of " << maxCycles;
+    }
+}
+
+TEST(ResumeTest, TestZeroBudget) {
+    MC68000 mc68000;
+    mc68000.rxdl = 29u;
+    mc68000.rydl = 5u;
+    mc68000.microword = DVUR1;
+    EXPECT_FALSE(mc68000.RunDivu(0u));
+    EXPECT_EQ(mc68000.microword, DVUR1);
+    EXPECT_EQ(mc68000.cycles, 0u);
+    EXPECT_TRUE(mc68000.RunDivu(1'000u));
+    EXPECT_EQ(mc68000.rxdl, 5u);
+    EXPECT_EQ(mc68000.rxdh, 4u);
+}
+
+TEST(ResumeTest, TestExitsNeedNoBudget) {
+    // The last microword ends exactly on the budget, the exit to A1 still happens in the same call
+    MC68000 mc68000;
+    mc68000.rxdh = 0x0001u; // Overflow, 10 cycles
+    mc68000.rydl = 1u;
+    mc68000.microword = DVUR1;
+    EXPECT_TRUE(mc68000.RunDivu(10u));
+    EXPECT_EQ(mc68000.microword, A1);
+    EXPECT_EQ(mc68000.cycles, 10u);
+
+    mc68000.rydl = 0u;
+    mc68000.cycles = 0u;
+    mc68000.microword = DVS01;
+    EXPECT_FALSE(mc68000.RunDivs(2u));
+    EXPECT_TRUE(mc68000.RunDivs(2u));
+    EXPECT_EQ(mc68000.microword, TRAP0);
+    EXPECT_EQ(mc68000.cycles, 4u);
+}
+
+TEST(ResumeTest, TestTraceSinkAcrossSlices) {
+    MC68000 mc68000;
+    mc68000.rxdl = 29u;
+    mc68000.rydl = 5u;
+    ProfileTraceSink whole;
+    mc68000.ExecuteDivu(whole);
+
+    MC68000 sliced;
+    sliced.rxdl = 29u;
+    sliced.rydl = 5u;
+    sliced.microword = DVUR1;
+    ProfileTraceSink slices;
+    while (!sliced.RunDivu(slices, 4u)) {}
+    EXPECT_EQ(slices.executions, whole.executions);
+}
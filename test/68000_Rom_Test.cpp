@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+
+#include "68000.h"
+#include "68000_Cycles.h"
+#include "68000_Reference.h"
+#include "68000_Rom.h"
+#include "68000_State.h"
+
+// The ROM runs in constant expressions, so these are checked by the compiler
+
+constexpr auto RomDivuMatches(uint32_t dividend, uint16_t divisor) -> bool {
+    const auto state = RomDivu(dividend, divisor);
+    const auto& [remainder, quotient] = DivideUnsigned(dividend, divisor);
+    return state.rxdh == remainder && state.rxdl == quotient && state.cycles == DivuCycles(dividend, divisor);
+}
+
+constexpr auto RomDivsMatches(uint32_t dividend, uint16_t divisor) -> bool {
+    const auto state = RomDivs(dividend, divisor);
+    const auto& [remainder, quotient] = DivideSigned(dividend, divisor);
+    return state.rxdh == remainder && state.rxdl == quotient && state.cycles == DivsCycles(dividend, divisor);
+}
+
+static_assert(RomDivuMatches(29u, 5u));
+static_assert(RomDivuMatches(9911u, 605u));
+static_assert(RomDivuMatches(0x5A'5A'00'08u, 0x5A5Bu));
+static_assert(RomDivuMatches(0xF5'AF'CC'DDu, 0xF6A6u));
+static_assert(RomDivuMatches(0x5A'5A'00'00u, 0x0001u)); // Overflow
+static_assert(RomDivuMatches(0x1234'5678u, 0u)); // Division by zero
+
+static_assert(RomDivsMatches(29u, 5u));
+static_assert(RomDivsMatches(-29, 5u));
+static_assert(RomDivsMatches(29u, -5));
+static_assert(RomDivsMatches(-29, -5));
+static_assert(RomDivsMatches(0x8000'0000u, 0x8000u)); // Overflow
+static_assert(RomDivsMatches(0x1234'5678u, 0u)); // Division by zero
+
+// Timing table built by the compiler from the microcode, the cycles of dividing 0xFFFF by each 8-bit divisor
+constexpr auto ROM_DIVU_CYCLES = [] {
+    std::array<uint32_t, 0x100u> cycles{};
+    for (auto divisor = 0u; divisor < cycles.size(); ++divisor) {
+        cycles[divisor] = RomDivu(0xFFFFu, divisor).cycles;
+    }
+    return cycles;
+}();
+
+static_assert(ROM_DIVU_CYCLES[0u] == 4u);
+static_assert(ROM_DIVU_CYCLES[1u] == DivuCycles(0xFFFFu, 1u));
+
+auto CompareRom(uint32_t dividend, uint16_t divisor, bool isSigned) -> void {
+    auto expected = LoadDivision(dividend, divisor);
+    expected.au = 0x1000u;
+    auto rom = expected;
+
+    if (isSigned) {
+        expected.ExecuteDivs();
+        rom.ExecuteRom(DVS01);
+    } else {
+        expected.ExecuteDivu();
+        rom.ExecuteRom(DVUR1);
+    }
+    SCOPED_TRACE(testing::Message() << "dividend " << dividend << " divisor " << divisor);
+    ExpectSameState(rom, expected);
+}
+
+constexpr uint32_t ROM_TEST_DIVIDENDS[] = {
+    0x0000'0000u, 0x0000'0001u, 0x0000'7FFFu, 0x0000'FFFFu, 0x0001'0000u, 0x1234'5678u,
+    0x7FFF'FFFFu, 0x8000'0000u, 0xFFFF'FFFFu, 0xFFFF'8000u, 0xFFFE'0000u, 0xDEAD'BEEFu,
+};
+
+TEST(RomTest, DivuMatchesMicrocode) {
+    for (auto divisor = 0u; divisor <= 0xFFFFu; ++divisor) {
+        for (const auto dividend : ROM_TEST_DIVIDENDS) {
+            CompareRom(dividend, divisor, false);
+        }
+    }
+}
+
+TEST(RomTest, DivsMatchesMicrocode) {
+    for (auto divisor = 0u; divisor <= 0xFFFFu; ++divisor) {
+        for (const auto dividend : ROM_TEST_DIVIDENDS) {
+            CompareRom(dividend, divisor, true);
+        }
+    }
+}
+
+TEST(RomTest, SharedNanowords) {
+    EXPECT_EQ(MICROCODE_ROM[DVUM7].nanoword, MICROCODE_ROM[DVUM8].nanoword);
+    EXPECT_EQ(MICROCODE_ROM[DVUM7].nanoword, MICROCODE_ROM[DVS0C].nanoword);
+    EXPECT_EQ(MICROCODE_ROM[DVUM3].nanoword, MICROCODE_ROM[DVS04].nanoword);
+    EXPECT_EQ(MICROCODE_ROM[DVUR1].nanoword, MICROCODE_ROM[DVS01].nanoword);
+    EXPECT_EQ(MICROCODE_ROM[TRAP0].nanoword, Nanoword::Exit);
+    EXPECT_EQ(MICROCODE_ROM[A1].nanoword, Nanoword::Exit);
+}
+
+TEST(RomTest, ConstexprTimingTable) {
+    for (auto divisor = 0u; divisor < ROM_DIVU_CYCLES.size(); ++divisor) {
+        EXPECT_EQ(ROM_DIVU_CYCLES[divisor], DivuCycles(0xFFFFu, divisor)) << "divisor " << divisor;
+    }
+}
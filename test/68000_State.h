@@ -0,0 +1,22 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "68000.h"
+
+// Every register of two processors, for the execute functions that must leave the same state as the microcode
+inline auto ExpectSameState(const MC68000& actual, const MC68000& expected) -> void {
+    EXPECT_EQ(actual.microword, expected.microword);
+    EXPECT_EQ(actual.rxdh, expected.rxdh);
+    EXPECT_EQ(actual.rxdl, expected.rxdl);
+    EXPECT_EQ(actual.rydl, expected.rydl);
+    EXPECT_EQ(actual.pc, expected.pc);
+    EXPECT_EQ(actual.alue, expected.alue);
+    EXPECT_EQ(actual.alub, expected.alub);
+    EXPECT_EQ(actual.alu, expected.alu);
+    EXPECT_EQ(actual.flags, expected.flags);
+    EXPECT_EQ(actual.au, expected.au);
+    EXPECT_EQ(actual.ath, expected.ath);
+    EXPECT_EQ(actual.atl, expected.atl);
+    EXPECT_EQ(actual.cycles, expected.cycles);
+}
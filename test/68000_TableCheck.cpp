@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "68000_Reference.h"
+#include "68000_Tables.h"
+
+// Checks the generated cycle tables and the DIVU shifted out correction against the reference models.
+// 68000_Division_TableGen fills the tables by running the microcode, the reference models are written
+// independently of it. The zero divisor entries are left out, the reference models give the exception timing
+// instead (see InstructionCycles).
+
+namespace {
+
+auto mismatches = 0u;
+
+auto CheckDivu(uint32_t dividend, uint16_t divisor) -> void {
+    const auto table = DivuTableCycles(dividend, divisor);
+    const auto reference = DivideUnsignedCycles(dividend, divisor);
+    if (table != reference && ++mismatches <= 20u) {
+        std::cerr << std::hex << "DIVU 0x" << dividend << " / 0x" << divisor << std::dec << ": table " << table
+                  << ", reference " << reference << std::endl;
+    }
+}
+
+auto CheckDivs(uint32_t dividend, uint16_t divisor) -> void {
+    const auto table = DivsTableCycles(dividend, divisor);
+    const auto reference = DivideSignedCycles(dividend, divisor);
+    if (table != reference && ++mismatches <= 20u) {
+        std::cerr << std::hex << "DIVS 0x" << dividend << " / 0x" << divisor << std::dec << ": table " << table
+                  << ", reference " << reference << std::endl;
+    }
+}
+
+// Remainders 0 and divisor - 1, and on both sides of the remainders where a quotient bit starts coming from a
+// shifted out msb
+auto DivuRemainders(uint32_t quotient, uint16_t divisor) -> std::vector<uint32_t> {
+    std::vector<uint32_t> remainders{ 0u, divisor - 1u };
+    for (auto j = 1u; j < 16u; ++j) {
+        const auto low = uint64_t{ quotient & ((2u << j) - 1u) };
+        const auto threshold = static_cast<int64_t>((uint64_t{ 1 } << (j + 16u)) - low * divisor);
+        if (threshold > 0 && threshold < divisor) {
+            remainders.push_back(static_cast<uint32_t>(threshold) - 1u);
+            remainders.push_back(static_cast<uint32_t>(threshold));
+        }
+    }
+    return remainders;
+}
+
+}
+
+auto main() -> int {
+    // Every DIVU_CYCLES and DIVS_CYCLES entry through divisors that reach them without a shifted out msb
+    for (auto pattern = 0u; pattern < QUOTIENT_PATTERNS; ++pattern) {
+        for (const auto quotient : { pattern << 1u, pattern << 1u | 1u }) {
+            for (const uint16_t divisor : { 1u, 3u, 0x7FFFu, 0x8000u }) {
+                CheckDivu(quotient * divisor, divisor);
+                CheckDivu(quotient * divisor + divisor - 1u, divisor);
+            }
+            for (const uint16_t divisor : { 1u, 0x7FFFu, 0xFFFFu, 0x8001u }) {
+                const auto absDivisor = (divisor & 0x8000u) ? 0x1'0000u - divisor : divisor;
+                const auto dividend = quotient * absDivisor + absDivisor / 2u;
+                CheckDivs(dividend, divisor);
+                CheckDivs(0u - dividend, divisor);
+            }
+        }
+    }
+
+    // The overflow exits
+    for (const uint16_t divisor : { 1u, 0x7FFFu, 0x8000u, 0xFFFFu }) {
+        CheckDivu(uint32_t{ divisor } << 16u, divisor);
+        CheckDivu(0xFFFF'FFFFu, divisor);
+        CheckDivs(0x7FFF'FFFFu, divisor);
+        CheckDivs(0x8000'0000u, divisor);
+    }
+
+    // The shifted out correction of every DIVU divisor above 0x8000, at random quotients
+    std::mt19937 random(5u);
+    for (auto divisor = 0x8001u; divisor < 0x1'0000u; ++divisor) {
+        for (auto i = 0u; i < 16u; ++i) {
+            const auto quotient = static_cast<uint32_t>(random()) & 0xFFFFu;
+            for (const auto remainder : DivuRemainders(quotient, static_cast<uint16_t>(divisor))) {
+                CheckDivu(quotient * divisor + remainder, static_cast<uint16_t>(divisor));
+            }
+        }
+    }
+
+    if (mismatches != 0u) {
+        std::cerr << mismatches << " mismatches against the reference models" << std::endl;
+        return 1;
+    }
+    return 0;
+}
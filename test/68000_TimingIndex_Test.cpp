@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Coverage.h"
+#include "68000_Coverage_Vectors.h"
+#include "68000_Distribution.h"
+#include "68000_TimingIndex.h"
+
+// The index must give the edges and cycles the microcode takes, and find every matching division once
+
+namespace {
+
+const TimingIndex& Index() {
+    static const TimingIndex index;
+    return index;
+}
+
+auto ExpectPathMatches(DivisionInstruction instruction, uint32_t dividend, uint16_t divisor) -> void {
+    const auto expected = CoveragePathOf({ instruction, dividend, divisor });
+    const auto actual = Index().PathOf(instruction, dividend, divisor);
+    SCOPED_TRACE(testing::Message() << ((instruction == DivisionInstruction::Divs) ? "DIVS " : "DIVU ") << std::hex
+                                    << dividend << " / " << divisor);
+    EXPECT_EQ(actual.edges, expected.edges);
+    EXPECT_EQ(actual.cycles, expected.cycles);
+}
+
+auto Find(const TimingQuery& query) -> std::vector<CoverageVector> {
+    std::vector<CoverageVector> found;
+    Index().Search(query, [&](uint32_t dividend, uint16_t divisor) {
+        found.push_back({ query.instruction, dividend, divisor });
+        return true;
+    });
+    return found;
+}
+
+}
+
+TEST(TimingIndexTest, TestPathsMatchMicrocode) {
+    for (const auto& vector : COVERAGE_VECTORS) {
+        ExpectPathMatches(vector.instruction, vector.dividend, vector.divisor);
+    }
+    std::mt19937 random(25u);
+    for (auto i = 0u; i < 20'000u; ++i) {
+        const auto dividend = static_cast<uint32_t>(random()) >> (random() % 32u);
+        const auto divisor = static_cast<uint16_t>(random() >> (random() % 16u));
+        ExpectPathMatches(DivisionInstruction::Divu, dividend, divisor);
+        ExpectPathMatches(DivisionInstruction::Divs, (i & 1u) ? 0u - dividend : dividend, divisor);
+    }
+}
+
+TEST(TimingIndexTest, TestCountsMatchHistograms) {
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        for (const uint16_t divisor : { 0u, 1u, 3u, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFBu, 0xFFFFu }) {
+            const auto histogram = CycleHistogramOf(instruction, divisor);
+            TimingQuery query{ .instruction = instruction, .firstDivisor = divisor, .lastDivisor = divisor };
+            EXPECT_EQ(Index().Count(query), uint64_t{ 1 } << 32u) << divisor;
+            for (auto cycles = 0u; cycles < CYCLE_HISTOGRAM_SIZE; ++cycles) {
+                if (histogram.counts[cycles] != 0u) {
+                    query.cycles = cycles;
+                    EXPECT_EQ(Index().Count(query), histogram.counts[cycles]) << divisor << " " << cycles;
+                }
+            }
+        }
+    }
+}
+
+TEST(TimingIndexTest, TestSearchFindsMatches) {
+    // The late overflow of a negative divisor and dividend
+    TimingQuery query{ .instruction = DivisionInstruction::Divs, .edges = { { DVS1E, DVUM4 } } };
+    query.limit = 1000u;
+    auto found = Find(query);
+    ASSERT_EQ(found.size(), 1000u);
+    for (const auto& vector : found) {
+        const auto path = CoveragePathOf(vector);
+        EXPECT_TRUE(std::ranges::binary_search(path.edges, MicrowordEdge{ DVS1E, DVUM4 }));
+    }
+
+    // The fewest cycles of a DIVU that runs the loop, every quotient bit from a shifted out msb
+    query = { .instruction = DivisionInstruction::Divu, .cycles = 76u, .edges = { { DVUM7, DVUM9 } } };
+    query.limit = 1000u;
+    found = Find(query);
+    ASSERT_FALSE(found.empty());
+    for (const auto& vector : found) {
+        const auto path = CoveragePathOf(vector);
+        EXPECT_EQ(path.cycles, 76u);
+        EXPECT_TRUE(std::ranges::binary_search(path.edges, MicrowordEdge{ DVUM7, DVUM9 }));
+    }
+    EXPECT_TRUE(std::ranges::is_sorted(found, {}, [](const CoverageVector& v) { return std::pair{ v.divisor, v.dividend }; }));
+}
+
+TEST(TimingIndexTest, TestSampling) {
+    TimingQuery query{ .instruction = DivisionInstruction::Divu, .cycles = 100u, .firstDivisor = 0x8001u, .lastDivisor = 0x8003u };
+    query.limit = 50'000u;
+    const auto all = Find(query);
+    ASSERT_EQ(all.size(), 50'000u);
+
+    query.every = 1000u;
+    query.limit = 50u;
+    const auto firsts = Find(query);
+    ASSERT_EQ(firsts.size(), 50u);
+    for (auto i = 0u; i < firsts.size(); ++i) {
+        EXPECT_EQ(firsts[i].dividend, all[i * 1000u].dividend);
+        EXPECT_EQ(firsts[i].divisor, all[i * 1000u].divisor);
+    }
+
+    query.seed = 7u;
+    const auto sampled = Find(query);
+    ASSERT_EQ(sampled.size(), 50u);
+    for (auto i = 0u; i < sampled.size(); ++i) {
+        const auto match = std::ranges::find_if(all.begin() + i * 1000u, all.begin() + (i + 1u) * 1000u, [&](const auto& v) {
+            return v.dividend == sampled[i].dividend && v.divisor == sampled[i].divisor;
+        });
+        EXPECT_NE(match, all.begin() + (i + 1u) * 1000u) << i;
+    }
+}
+
+TEST(TimingIndexTest, TestNoMatches) {
+    // An edge of the other instruction, and cycles no division takes
+    EXPECT_EQ(Index().Count({ .instruction = DivisionInstruction::Divu, .edges = { { DVS1E, DVUM4 } } }), 0u);
+    EXPECT_EQ(Index().Count({ .instruction = DivisionInstruction::Divs, .cycles = 1u }), 0u);
+    TimingQuery query{ .instruction = DivisionInstruction::Divu };
+    query.limit = 0u;
+    EXPECT_EQ(Index().Search(query, [](uint32_t, uint16_t) { return true; }), 0u);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "68000_Cycles.h"
+#include "68000_Timing.h"
+
+// Whole instruction timings checked against the tables of docs-third-party/Yacht.txt
+
+namespace {
+
+constexpr uint16_t DIVU_OPCODE = 0x80C0u; // DIVU <ea>,D0
+constexpr uint16_t DIVS_OPCODE = 0x81C0u;
+constexpr uint16_t MULU_OPCODE = 0xC0C0u;
+constexpr uint16_t MULS_OPCODE = 0xC1C0u;
+
+struct EaTiming {
+    uint16_t field;
+    uint32_t cycles;
+};
+
+// One field per mode, with Yacht.txt's .B/.W effective address calculation times
+constexpr EaTiming EA_TIMINGS[] = {
+    { 0x01u, 0u }, // D1
+    { 0x12u, 4u }, // (A2)
+    { 0x1Bu, 4u }, // (A3)+
+    { 0x24u, 6u }, // -(A4)
+    { 0x2Du, 8u }, // (d16,A5)
+    { 0x36u, 10u }, // (d8,A6,Xn)
+    { 0x38u, 8u }, // (xxx).W
+    { 0x39u, 12u }, // (xxx).L
+    { 0x3Au, 8u }, // (d16,PC)
+    { 0x3Bu, 10u }, // (d8,PC,Xn)
+    { 0x3Cu, 4u }, // #<data>
+};
+
+}
+
+TEST(TimingTest, TestDecodeEaMode) {
+    EXPECT_EQ(DecodeEaMode(0x07u), EaMode::DataRegister);
+    EXPECT_EQ(DecodeEaMode(0x0Fu), EaMode::AddressRegister);
+    EXPECT_EQ(DecodeEaMode(0x38u), EaMode::AbsoluteShort);
+    EXPECT_EQ(DecodeEaMode(0x3Cu), EaMode::Immediate);
+    EXPECT_EQ(DecodeEaMode(0x3Du), EaMode::Invalid);
+    EXPECT_EQ(DecodeEaMode(0x3Fu), EaMode::Invalid);
+}
+
+TEST(TimingTest, TestOpcodes) {
+    for (auto destination = 0u; destination < 8u; ++destination) {
+        for (const auto opcode : { DIVU_OPCODE, DIVS_OPCODE, MULU_OPCODE, MULS_OPCODE }) {
+            EXPECT_TRUE(IsTimedOpcode(static_cast<uint16_t>(opcode | destination << 9u | 0x3Fu)));
+        }
+    }
+    EXPECT_FALSE(IsTimedOpcode(0x8040u)); // OR.W
+    EXPECT_FALSE(IsTimedOpcode(0xC140u)); // EXG
+    EXPECT_FALSE(IsTimedOpcode(0x90C0u)); // SUBA.W
+    EXPECT_FALSE(IsTimedOpcode(0x4E71u)); // NOP
+    EXPECT_EQ(InstructionCycles(0x4E71u, 0u, 0u), 0u);
+}
+
+TEST(TimingTest, TestEveryEaMode) {
+    for (const auto& ea : EA_TIMINGS) {
+        for (const auto dividend : { 29u, 0x0004'3210u, 0xFFFF'FFE3u }) {
+            for (const uint16_t divisor : { 1u, 5u, 0x7FFFu, 0xFFFBu }) {
+                EXPECT_EQ(InstructionCycles(DIVU_OPCODE | ea.field, dividend, divisor),
+                          ea.cycles + DivuCycles(dividend, divisor));
+                EXPECT_EQ(InstructionCycles(DIVS_OPCODE | ea.field, dividend, divisor),
+                          ea.cycles + DivsCycles(dividend, divisor));
+            }
+        }
+        for (const uint16_t multiplier : { 0u, 0x5555u, 0xFFFFu }) {
+            EXPECT_EQ(InstructionCycles(MULU_OPCODE | ea.field, 3u, multiplier), ea.cycles + MuluCycles(multiplier));
+            EXPECT_EQ(InstructionCycles(MULS_OPCODE | ea.field, 3u, multiplier), ea.cycles + MulsCycles(multiplier));
+        }
+    }
+}
+
+TEST(TimingTest, TestYachtExits) {
+    // Overflow
+    EXPECT_EQ(InstructionCycles(DIVU_OPCODE | 0x01u, 0x0001'0000u, 1u), 10u);
+    EXPECT_EQ(InstructionCycles(DIVU_OPCODE | 0x39u, 0x0001'0000u, 1u), 12u + 10u);
+    EXPECT_EQ(InstructionCycles(DIVS_OPCODE | 0x01u, 0x7FFF'0000u, 1u), 16u);
+    EXPECT_EQ(InstructionCycles(DIVS_OPCODE | 0x01u, 0x8000'0000u, 1u), 18u);
+
+    // Divide by zero, 38 + ea
+    for (const auto& ea : EA_TIMINGS) {
+        EXPECT_EQ(InstructionCycles(DIVU_OPCODE | ea.field, 0x1234'5678u, 0u), 38u + ea.cycles);
+        EXPECT_EQ(InstructionCycles(DIVS_OPCODE | ea.field, 0x8765'4321u, 0u), 38u + ea.cycles);
+    }
+
+    // An source and mode 7 with register 5 to 7
+    for (const auto opcode : { DIVU_OPCODE, DIVS_OPCODE, MULU_OPCODE, MULS_OPCODE }) {
+        EXPECT_EQ(InstructionCycles(static_cast<uint16_t>(opcode | 0x09u), 29u, 5u), 34u);
+        EXPECT_EQ(InstructionCycles(static_cast<uint16_t>(opcode | 0x3Eu), 29u, 5u), 34u);
+    }
+}
+
+TEST(TimingTest, TestYachtBestAndWorst) {
+    EXPECT_EQ(InstructionCycles(DIVU_OPCODE, 0xFFFE'0001u, 0xFFFFu), 76u); // Quotient 0xFFFF
+    EXPECT_EQ(InstructionCycles(DIVU_OPCODE, 0u, 1u), 136u); // Quotient 0
+    EXPECT_EQ(InstructionCycles(DIVS_OPCODE, 0x0000'7FFFu, 1u), 122u);
+    EXPECT_EQ(InstructionCycles(DIVS_OPCODE, 0xFFFF'FFFFu, 1u), 156u);
+    EXPECT_EQ(InstructionCycles(MULU_OPCODE, 0u, 0u), 38u);
+    EXPECT_EQ(InstructionCycles(MULU_OPCODE, 0u, 0xFFFFu), 70u);
+    EXPECT_EQ(InstructionCycles(MULS_OPCODE, 0u, 0x5555u), 70u);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "68000.h"
+#include "68000_Profile.h"
+#include "68000_TraceFile.h"
+
+namespace {
+
+auto TracePath(const char* name) -> std::string {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+}
+
+TEST(TraceFileTest, TestOneRecordPerMicroword) {
+    const auto path = TracePath("68000_TraceFile_Test_1.trace");
+    MC68000 mc68000;
+    mc68000.rxdl = 29u;
+    mc68000.rydl = 5u;
+    {
+        BinaryTraceSink sink(7u); // Smaller than the trace, so the buffer is written more than once
+        ASSERT_TRUE(sink.Open(path));
+        mc68000.ExecuteDivu(sink);
+    }
+    MC68000 profiled;
+    profiled.rxdl = 29u;
+    profiled.rydl = 5u;
+    ProfileTraceSink profile;
+    profiled.ExecuteDivu(profile);
+
+    MappedTrace trace;
+    ASSERT_TRUE(trace.Open(path));
+    auto microwords = 0u;
+    for (const auto executions : profile.executions) {
+        microwords += executions;
+    }
+    ASSERT_EQ(trace.Size(), microwords);
+    EXPECT_EQ(trace[0u].microword, DVUR1);
+    EXPECT_EQ(trace[0u].cycles, 2u);
+    EXPECT_EQ(trace[trace.Size() - 1u].microword, A1);
+    EXPECT_EQ(trace[trace.Size() - 2u].cycles, mc68000.cycles);
+    for (std::size_t i = 1u; i < trace.Size(); ++i) {
+        EXPECT_EQ(trace[i].cycles, trace[i - 1u].cycles + 2u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(TraceFileTest, TestAppendAndRegisters) {
+    const auto path = TracePath("68000_TraceFile_Test_2.trace");
+    std::size_t first{};
+    for (auto i = 0u; i < 2u; ++i) {
+        BinaryTraceSink sink;
+        ASSERT_TRUE(sink.Open(path));
+        MC68000 mc68000;
+        mc68000.rxdh = 0xFFFFu;
+        mc68000.rxdl = static_cast<uint16_t>(-29);
+        mc68000.rydl = 5u;
+        mc68000.ExecuteDivs(sink);
+        ASSERT_TRUE(sink.Close());
+        if (i == 0u) {
+            MappedTrace trace;
+            ASSERT_TRUE(trace.Open(path));
+            first = trace.Size();
+        }
+    }
+
+    // The second run appended an identical trace after the first
+    MappedTrace trace;
+    ASSERT_TRUE(trace.Open(path));
+    ASSERT_EQ(trace.Size(), 2u * first);
+    for (std::size_t i = 0u; i < first; ++i) {
+        EXPECT_EQ(trace[i].microword, trace[first + i].microword);
+        EXPECT_EQ(trace[i].alu, trace[first + i].alu);
+        EXPECT_EQ(trace[i].au, trace[first + i].au);
+        EXPECT_EQ(trace[i].flags, trace[first + i].flags);
+    }
+    EXPECT_EQ(trace[first].microword, DVS01);
+    std::filesystem::remove(path);
+}
+
+TEST(TraceFileTest, TestRejectsOtherFiles) {
+    const auto path = TracePath("68000_TraceFile_Test_3.trace");
+    auto* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a trace file", file);
+    std::fclose(file);
+
+    BinaryTraceSink sink;
+    EXPECT_FALSE(sink.Open(path));
+    MappedTrace trace;
+    EXPECT_FALSE(trace.Open(path));
+    std::filesystem::remove(path);
+}
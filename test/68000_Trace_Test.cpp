@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "68000.h"
+#include "68000_Trace.h"
+
+TEST(TraceTest, TestDivuRecordsEveryIteration) {
+    MC68000 mc68000;
+    RingTraceSink sink(64u);
+    mc68000.rxdh = 0x0004u;
+    mc68000.rxdl = 0x3210u;
+    mc68000.rydl = 0x5A5Bu;
+    mc68000.ExecuteDivu(sink);
+    // DVUM3 followed by one DVUM5/6 per iteration
+    ASSERT_EQ(sink.Size(), 1u + 16u);
+    EXPECT_EQ(sink[0].microword, DVUM3);
+    EXPECT_EQ(sink[0].au, 16u);
+    EXPECT_EQ(sink[16].au, 0u);
+    EXPECT_EQ(sink[16].rydl, 0x5A5Bu);
+}
+
+TEST(TraceTest, TestDivsRecordsEveryIteration) {
+    MC68000 mc68000;
+    RingTraceSink sink(64u);
+    mc68000.rxdh = 0xFFFFu;
+    mc68000.rxdl = static_cast<uint16_t>(-29);
+    mc68000.rydl = 5u;
+    mc68000.ExecuteDivs(sink);
+    // DVS08, one DVS09/A per iteration, DVS12/13 and DVS14
+    ASSERT_EQ(sink.Size(), 1u + 16u + 2u);
+    EXPECT_EQ(sink[0].microword, DVS08);
+    EXPECT_EQ(sink[18].microword, DVS14);
+}
+
+TEST(TraceTest, TestRingKeepsMostRecentRecords) {
+    MC68000 mc68000;
+    RingTraceSink sink(4u);
+    mc68000.rxdh = 0u;
+    mc68000.rxdl = 29u;
+    mc68000.rydl = 5u;
+    mc68000.ExecuteDivu(sink);
+    ASSERT_EQ(sink.Size(), 4u);
+    EXPECT_EQ(sink.total, 17u);
+    EXPECT_EQ(sink[0].au, 3u);
+    EXPECT_EQ(sink[3].au, 0u);
+}
+
+TEST(TraceTest, TestOverflowRecordsOnce) {
+    MC68000 mc68000;
+    RingTraceSink sink(4u);
+    mc68000.rxdh = 0x5A5Au;
+    mc68000.rxdl = 0u;
+    mc68000.rydl = 1u;
+    mc68000.ExecuteDivu(sink);
+    ASSERT_EQ(sink.Size(), 1u);
+    EXPECT_EQ(sink[0].microword, DVUM3);
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include "68000.h"
+#include "68000_Coverage.h"
+
+// Writes the divisions of MinimalCoverage (68000_Coverage.h) as a gtest parameter table, sorted by
+// instruction and cycles. Each line notes the cycles and the edges no line above it takes.
+//
+//     68000_Division_Coverage OUT
+//
+// The table in the tests is test/68000_Coverage_Vectors.h, regenerate it when the microcode changes.
+
+namespace {
+
+auto Hex(uint32_t value, int digits) -> std::string {
+    char text[16];
+    if (digits == 8) {
+        std::snprintf(text, sizeof(text), "0x%04X'%04Xu", value >> 16u, value & 0xFFFFu);
+    } else {
+        std::snprintf(text, sizeof(text), "0x%04Xu", value);
+    }
+    return text;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " OUT" << std::endl;
+        return 2;
+    }
+    auto result = MinimalCoverage();
+    const auto order = [](const CoverageVector& v) {
+        return std::tuple{ v.instruction, CoveragePathOf(v).cycles, v.divisor, v.dividend };
+    };
+    std::sort(result.vectors.begin(), result.vectors.end(), [&](const auto& a, const auto& b) { return order(a) < order(b); });
+
+    std::ofstream file(argv[1]);
+    file << "// Generated by 68000_Division_Coverage, do not edit\n"
+            "// Takes every edge between the DIVU and DIVS microwords a division can take and every cycle count,\n"
+            "// see 68000_Coverage.h\n"
+            "\n"
+            "#pragma once\n"
+            "\n"
+            "#include \"68000_Coverage.h\"\n"
+            "\n"
+            "inline constexpr CoverageVector COVERAGE_VECTORS[] = {\n";
+    std::set<MicrowordEdge> seen;
+    for (const auto& vector : result.vectors) {
+        const auto path = CoveragePathOf(vector);
+        file << "    { DivisionInstruction::" << ((vector.instruction == DivisionInstruction::Divs) ? "Divs" : "Divu")
+             << ", " << Hex(vector.dividend, 8) << ", " << Hex(vector.divisor, 4) << " }, // " << path.cycles << " cycles";
+        auto separator = ", ";
+        for (const auto& edge : path.edges) {
+            if (seen.insert(edge).second) {
+                file << separator << MICROWORD_NAMES[edge.first] << ">" << MICROWORD_NAMES[edge.second];
+                separator = " ";
+            }
+        }
+        file << "\n";
+    }
+    file << "};\n";
+    if (!file) {
+        std::cerr << "Failed to write " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << result.vectors.size() << " divisions" << std::endl;
+    auto complete = true;
+    for (const auto instruction : { DivisionInstruction::Divu, DivisionInstruction::Divs }) {
+        const auto& uncovered = result.uncovered[static_cast<int>(instruction)];
+        const auto name = (instruction == DivisionInstruction::Divs) ? "DIVS" : "DIVU";
+        for (const auto& [from, to] : uncovered.edges) {
+            std::cout << name << " edge " << MICROWORD_NAMES[from] << ">" << MICROWORD_NAMES[to] << " not covered" << std::endl;
+            complete = false;
+        }
+        for (const auto cycles : uncovered.cycles) {
+            std::cout << name << " " << cycles << " cycles not covered" << std::endl;
+            complete = false;
+        }
+    }
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "68000_Dividers.h"
+#include "68000_Distribution.h"
+#include "68000_Tables.h"
+
+// Cycle count distributions of DIVU and DIVS over the whole operand space.
+//
+// histogram counts the cycles of all 2^32 dividends of every divisor in the range analytically
+// (68000_Distribution.h), prints the combined histogram with min, max and mean, and optionally writes
+// the histogram of each divisor
+//     instruction,model,divisor,cycles,count
+//     DIVU,restoring,0x8001,10,2147418112
+//
+// heatmap splits dividend (x) by divisor (y) into tiles, samples random operands in each tile on every core
+// and writes the mean or maximum cycles of the tiles as an 8 bit binary PGM image, scaled from the lowest
+// to the highest tile.
+//
+// --model picks one of the what-if dividers of 68000_Dividers.h in place of the 68000's restoring division.
+//
+//     68000_Division_Distribution histogram divu|divs [--model M] [--divisors FIRST:LAST] [--threads T] [--csv FILE]
+//     68000_Division_Distribution heatmap divu|divs OUT [--model M] [--width W] [--height H] [--samples N] [--max]
+//                                 [--seed S] [--threads T]
+
+namespace {
+
+struct Options {
+    DivisionInstruction instruction{ DivisionInstruction::Divu };
+    DividerModel model{ DividerModel::Restoring };
+    std::string output;
+    uint32_t firstDivisor{ 0u };
+    uint32_t lastDivisor{ 0xFFFFu };
+    std::string csv;
+    uint32_t width{ 512u };
+    uint32_t height{ 512u };
+    uint32_t samples{ 64u }; // Per tile
+    bool max{ false };
+    uint64_t seed{ 1u };
+    unsigned threads{ std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+auto InstructionName(DivisionInstruction instruction) -> const char* {
+    return (instruction == DivisionInstruction::Divs) ? "DIVS" : "DIVU";
+}
+
+// Runs work(index) for every index below count, handed out one at a time to the threads
+template<typename Work>
+auto ParallelFor(uint32_t count, unsigned threads, Work work) -> void {
+    std::atomic<uint32_t> next{};
+    std::vector<std::thread> workers;
+    for (auto i = 0u; i < threads; ++i) {
+        workers.emplace_back([&] {
+            for (auto index = next++; index < count; index = next++) {
+                work(index);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+auto Histogram(const Options& options) -> int {
+    const auto count = options.lastDivisor - options.firstDivisor + 1u;
+    // Only the cycles that occur are kept for each divisor
+    std::vector<std::vector<std::pair<uint8_t, uint64_t>>> divisors(count);
+    std::vector<double> means(count);
+    const auto start = std::chrono::steady_clock::now();
+    ParallelFor(count, options.threads, [&](uint32_t index) {
+        const auto histogram = CycleHistogramOf(options.model, options.instruction,
+                                                static_cast<uint16_t>(options.firstDivisor + index));
+        for (auto cycles = 0u; cycles < CYCLE_HISTOGRAM_SIZE; ++cycles) {
+            if (histogram.counts[cycles] != 0u) {
+                divisors[index].emplace_back(cycles, histogram.counts[cycles]);
+            }
+        }
+        means[index] = histogram.Mean();
+    });
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    CycleHistogram total;
+    for (const auto& counts : divisors) {
+        for (const auto& [cycles, n] : counts) {
+            total.Add(cycles, n);
+        }
+    }
+    const auto worst = std::max_element(means.begin(), means.end()) - means.begin();
+    std::cout << InstructionName(options.instruction) << " " << DividerModelName(options.model) << ", divisors 0x"
+              << std::hex << options.firstDivisor << " to 0x" << options.lastDivisor << std::dec << ", " << total.Total() << " divisions in " << seconds << " s\n"
+              << "min " << total.Min() << ", max " << total.Max() << ", mean " << total.Mean()
+              << ", highest divisor mean " << means[worst] << " (0x" << std::hex << options.firstDivisor + worst
+              << std::dec << ")\n"
+              << "cycles,count,percent\n";
+    for (auto cycles = 0u; cycles < CYCLE_HISTOGRAM_SIZE; ++cycles) {
+        if (total.counts[cycles] != 0u) {
+            std::cout << cycles << "," << total.counts[cycles] << ","
+                      << 100.0 * static_cast<double>(total.counts[cycles]) / static_cast<double>(total.Total()) << "\n";
+        }
+    }
+    std::cout << std::flush;
+
+    if (!options.csv.empty()) {
+        std::ofstream file(options.csv);
+        file << "instruction,model,divisor,cycles,count\n";
+        for (auto index = 0u; index < count; ++index) {
+            for (const auto& [cycles, n] : divisors[index]) {
+                file << InstructionName(options.instruction) << "," << DividerModelName(options.model) << ",0x"
+                     << std::hex << std::setw(4) << std::setfill('0') << options.firstDivisor + index << std::dec << "," << static_cast<unsigned>(cycles) << "," << n << "\n";
+            }
+        }
+        if (!file) {
+            std::cerr << "Failed to write " << options.csv << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+auto Heatmap(const Options& options) -> int {
+    const auto tileDividends = (uint64_t{ 1 } << 32u) / options.width;
+    const auto tileDivisors = (uint64_t{ 1 } << 16u) / options.height;
+    std::vector<double> tiles(uint64_t{ options.width } * options.height);
+    ParallelFor(options.height, options.threads, [&](uint32_t y) {
+        // Seeded by row so the image doesn't depend on the number of threads
+        std::mt19937_64 random(options.seed + y);
+        for (auto x = 0u; x < options.width; ++x) {
+            auto sum = 0.0;
+            auto max = 0u;
+            for (auto i = 0u; i < options.samples; ++i) {
+                const auto dividend = static_cast<uint32_t>(x * tileDividends + random() % tileDividends);
+                const auto divisor = static_cast<uint16_t>(y * tileDivisors + random() % tileDivisors);
+                const auto cycles = (options.model != DividerModel::Restoring) ?
+                                    DividerCycles(options.model, options.instruction, dividend, divisor) :
+                                    (options.instruction == DivisionInstruction::Divs) ?
+                                    DivsTableCycles(dividend, divisor) : DivuTableCycles(dividend, divisor);
+                sum += cycles;
+                max = std::max(max, cycles);
+            }
+            tiles[uint64_t{ y } * options.width + x] = options.max ? max : sum / options.samples;
+        }
+    });
+
+    const auto [low, high] = std::minmax_element(tiles.begin(), tiles.end());
+    const auto range = std::max(*high - *low, 1.0);
+    std::ofstream file(options.output, std::ios::binary);
+    file << "P5\n" << options.width << " " << options.height << "\n255\n";
+    for (const auto tile : tiles) {
+        file.put(static_cast<char>(static_cast<uint8_t>((tile - *low) * 255.0 / range + 0.5)));
+    }
+    if (!file) {
+        std::cerr << "Failed to write " << options.output << std::endl;
+        return 1;
+    }
+    std::cout << InstructionName(options.instruction) << " " << DividerModelName(options.model) << " "
+              << (options.max ? "max" : "mean") << " cycles from " << *low << " (black) to " << *high
+              << " (white), dividends 0x" << std::hex << tileDividends << " and divisors 0x" << tileDivisors << std::dec << " per pixel" << std::endl;
+    return 0;
+}
+
+auto ParseOptions(int argc, char* argv[], bool heatmap, Options& options) -> bool {
+    const std::string instruction = argv[2];
+    if (instruction != "divu" && instruction != "divs") {
+        return false;
+    }
+    options.instruction = (instruction == "divs") ? DivisionInstruction::Divs : DivisionInstruction::Divu;
+    auto i = 3;
+    if (heatmap) {
+        if (argc < 4) {
+            return false;
+        }
+        options.output = argv[i++];
+    }
+    for (; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--max") {
+            options.max = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--model") {
+            const auto model = std::find_if(std::begin(DIVIDER_MODELS), std::end(DIVIDER_MODELS),
+                                            [&](DividerModel m) { return value == DividerModelName(m); });
+            if (model == std::end(DIVIDER_MODELS)) {
+                return false;
+            }
+            options.model = *model;
+        } else if (arg == "--divisors" && !heatmap) {
+            const auto colon = value.find(':');
+            options.firstDivisor = static_cast<uint32_t>(std::stoul(value.substr(0u, colon), nullptr, 0));
+            options.lastDivisor = (colon == std::string::npos) ? options.firstDivisor :
+                                  static_cast<uint32_t>(std::stoul(value.substr(colon + 1u), nullptr, 0));
+        } else if (arg == "--csv" && !heatmap) {
+            options.csv = value;
+        } else if (arg == "--width" && heatmap) {
+            options.width = static_cast<uint32_t>(std::stoul(value, nullptr, 0));
+        } else if (arg == "--height" && heatmap) {
+            options.height = static_cast<uint32_t>(std::stoul(value, nullptr, 0));
+        } else if (arg == "--samples" && heatmap) {
+            options.samples = std::max(1u, static_cast<uint32_t>(std::stoul(value, nullptr, 0)));
+        } else if (arg == "--seed" && heatmap) {
+            options.seed = std::stoull(value, nullptr, 0);
+        } else if (arg == "--threads") {
+            options.threads = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+        } else {
+            return false;
+        }
+    }
+    // Tiles are at least one operand wide
+    return options.firstDivisor <= options.lastDivisor && options.lastDivisor <= 0xFFFFu &&
+           options.width >= 1u && options.width <= 0x1'0000u && options.height >= 1u && options.height <= 0x1'0000u;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    const std::string command = (argc > 2) ? argv[1] : "";
+    Options options;
+    try {
+        if (command == "histogram" && ParseOptions(argc, argv, false, options)) {
+            return Histogram(options);
+        }
+        if (command == "heatmap" && ParseOptions(argc, argv, true, options)) {
+            return Heatmap(options);
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid option value" << std::endl;
+        return 2;
+    }
+    std::cerr << "Usage: " << argv[0] << " histogram divu|divs [--model M] [--divisors FIRST:LAST] [--threads T]"
+                                         " [--csv FILE]\n"
+              << "       " << argv[0] << " heatmap divu|divs OUT [--model M] [--width W] [--height H] [--samples N]"
+                                         " [--max] [--seed S] [--threads T]\n"
+              << "Models: restoring (the 68000), nonrestoring, srt4" << std::endl;
+    return 2;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "68000.h"
+#include "68000_Cycles.h"
+#include "68000_TimingIndex.h"
+
+// Finds operands by their timing with a TimingIndex (68000_TimingIndex.h), for reproducing a cycle count or a
+// path through the microcode. Writes the matches, in order of divisor and dividend, as
+//     dividend,divisor,cycles
+//     0x00008000,0x0001,...
+//
+//     68000_Division_Find divu|divs [--cycles N] [--edge FROM>TO]... [--divisors FIRST:LAST] [--limit N]
+//                         [--every N] [--seed S] [--count]
+//
+// --edge takes microword names, --edge DVS1E>DVUM4 for the late DIVS overflow of a negative divisor and dividend.
+// --every N --seed S finds a random one of every N matches, --count only counts them.
+
+namespace {
+
+auto ParseEdge(const std::string& value, MicrowordEdge& edge) -> bool {
+    const auto separator = value.find('>');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    const auto label = [](const std::string& name) {
+        return static_cast<uint16_t>(std::find(std::begin(MICROWORD_NAMES), std::end(MICROWORD_NAMES), name) -
+                                     std::begin(MICROWORD_NAMES));
+    };
+    edge = { label(value.substr(0u, separator)), label(value.substr(separator + 1u)) };
+    return edge.first < MICROWORD_COUNT && edge.second < MICROWORD_COUNT;
+}
+
+auto ParseOptions(int argc, char* argv[], TimingQuery& query, bool& count) -> bool {
+    const std::string instruction = argv[1];
+    if (instruction != "divu" && instruction != "divs") {
+        return false;
+    }
+    query.instruction = (instruction == "divs") ? DivisionInstruction::Divs : DivisionInstruction::Divu;
+    query.limit = 100u;
+    for (auto i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--count") {
+            count = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--cycles") {
+            query.cycles = static_cast<uint32_t>(std::stoul(value, nullptr, 0));
+        } else if (arg == "--edge") {
+            MicrowordEdge edge;
+            if (!ParseEdge(value, edge)) {
+                return false;
+            }
+            query.edges.push_back(edge);
+        } else if (arg == "--divisors") {
+            const auto colon = value.find(':');
+            const auto first = std::stoul(value.substr(0u, colon), nullptr, 0);
+            const auto last = (colon == std::string::npos) ? first : std::stoul(value.substr(colon + 1u), nullptr, 0);
+            if (first > last || last > 0xFFFFu) {
+                return false;
+            }
+            query.firstDivisor = static_cast<uint16_t>(first);
+            query.lastDivisor = static_cast<uint16_t>(last);
+        } else if (arg == "--limit") {
+            query.limit = std::stoull(value, nullptr, 0);
+        } else if (arg == "--every") {
+            query.every = std::max(std::stoull(value, nullptr, 0), 1ull);
+        } else if (arg == "--seed") {
+            query.seed = std::stoull(value, nullptr, 0);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    TimingQuery query;
+    auto count = false;
+    try {
+        if (argc < 2 || !ParseOptions(argc, argv, query, count)) {
+            std::cerr << "Usage: " << argv[0] << " divu|divs [--cycles N] [--edge FROM>TO]... [--divisors FIRST:LAST]"
+                                                 " [--limit N] [--every N] [--seed S] [--count]" << std::endl;
+            return 2;
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid option value" << std::endl;
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const TimingIndex index;
+    const auto built = std::chrono::steady_clock::now();
+    auto found = uint64_t{};
+    if (count) {
+        found = index.Count(query);
+    } else {
+        std::cout << "dividend,divisor,cycles\n";
+        found = index.Search(query, [&](uint32_t dividend, uint16_t divisor) {
+            char line[48];
+            const auto cycles = (query.instruction == DivisionInstruction::Divs) ? DivsCycles(dividend, divisor) :
+                                                                                   DivuCycles(dividend, divisor);
+            std::snprintf(line, sizeof(line), "0x%08X,0x%04X,%u\n", dividend, divisor, cycles);
+            std::cout << line;
+            return true;
+        });
+        std::cout << std::flush;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cerr << found << (count ? " matches" : " operands") << ", index built in "
+              << std::chrono::duration<double, std::milli>(built - start).count() << " ms, searched in "
+              << std::chrono::duration<double, std::milli>(end - built).count() << " ms" << std::endl;
+    return (found != 0u) ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Reference.h"
+
+// Differential fuzzer for DIVU and DIVS against the reference models.
+//
+// Each case runs the microcode with tracing compiled out and compares the remainder, quotient, rydl,
+// the flags (when the division doesn't overflow) and the cycles (when the divisor isn't zero).
+//
+// Built with M68K_LIBFUZZER the file provides LLVMFuzzerTestOneInput, reading the input as 6 byte
+// little endian (dividend, divisor) records, and libFuzzer drives it.
+// Otherwise the standalone driver generates cases on every core: uniform random operands, operands
+// biased towards the sign, overflow and 0x8000 boundaries, and mutations of those.
+// Mismatches are minimized to the fewest set bits that still mismatch and appended to the regression file
+//     DIVS 0x00008000 0x0001
+// which --replay runs again.
+//
+//     68000_Division_Fuzz [--cases N] [--seed S] [--threads T] [--regressions FILE] [--replay FILE]
+
+namespace {
+
+enum class Instruction {
+    Divu,
+    Divs,
+};
+
+struct Case {
+    Instruction instruction;
+    uint32_t dividend;
+    uint16_t divisor;
+};
+
+auto Mismatches(const Case& c) -> bool {
+    auto mc68000 = LoadDivision(c.dividend, c.divisor);
+    uint16_t remainder, quotient;
+    uint32_t cycles;
+    bool overflows;
+    if (c.instruction == Instruction::Divs) {
+        mc68000.ExecuteDivs();
+        const auto result = DivideSigned(c.dividend, c.divisor);
+        remainder = result.remainder;
+        quotient = result.quotient;
+        cycles = DivideSignedCycles(c.dividend, c.divisor);
+        overflows = DivideSignedOverflows(c.dividend, c.divisor);
+    } else {
+        mc68000.ExecuteDivu();
+        const auto result = DivideUnsigned(c.dividend, c.divisor);
+        remainder = result.remainder;
+        quotient = result.quotient;
+        cycles = DivideUnsignedCycles(c.dividend, c.divisor);
+        overflows = DivideUnsignedOverflows(c.dividend, c.divisor);
+    }
+    // The reference models don't include the exception timing, so division by zero doesn't check the cycles
+    return mc68000.rxdh != remainder ||
+           mc68000.rxdl != quotient ||
+           mc68000.rydl != c.divisor ||
+           (!overflows && (mc68000.flags & (FLAG_N | FLAG_Z | FLAG_V | FLAG_C)) != DivideFlags(quotient)) ||
+           (c.divisor != 0u && mc68000.cycles != cycles);
+}
+
+// Clears bits of the operands for as long as the case still mismatches
+auto Minimize(Case c) -> Case {
+    auto progress = true;
+    while (progress) {
+        progress = false;
+        for (auto bit = 32u; bit-- > 0u && !progress;) {
+            auto candidate = c;
+            candidate.dividend &= ~(1u << bit);
+            if (candidate.dividend != c.dividend && Mismatches(candidate)) {
+                c = candidate;
+                progress = true;
+            }
+        }
+        for (auto bit = 16u; bit-- > 0u && !progress;) {
+            auto candidate = c;
+            candidate.divisor &= ~(1u << bit);
+            if (candidate.divisor != c.divisor && Mismatches(candidate)) {
+                c = candidate;
+                progress = true;
+            }
+        }
+    }
+    return c;
+}
+
+auto Format(const Case& c) -> std::string {
+    char line[32];
+    std::snprintf(line, sizeof(line), "%s 0x%08X 0x%04X", (c.instruction == Instruction::Divs) ? "DIVS" : "DIVU",
+                  static_cast<unsigned>(c.dividend), static_cast<unsigned>(c.divisor));
+    return line;
+}
+
+}
+
+#if M68K_LIBFUZZER
+
+extern "C" auto LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size) -> int {
+    for (; size >= 6u; data += 6u, size -= 6u) {
+        const auto dividend = static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8u |
+                              static_cast<uint32_t>(data[2]) << 16u | static_cast<uint32_t>(data[3]) << 24u;
+        const auto divisor = static_cast<uint16_t>(data[4] | data[5] << 8u);
+        for (const auto instruction : { Instruction::Divu, Instruction::Divs }) {
+            const Case c = { instruction, dividend, divisor };
+            if (Mismatches(c)) {
+                std::cerr << "Mismatch: " << Format(c) << ", minimized: " << Format(Minimize(c)) << std::endl;
+                std::abort();
+            }
+        }
+    }
+    return 0;
+}
+
+#else
+
+namespace {
+
+struct Options {
+    uint64_t cases{ uint64_t{ 1u } << 30u };
+    uint64_t seed{ 1u };
+    unsigned threads{ std::max(1u, std::thread::hardware_concurrency()) };
+    std::string regressions{ "fuzz.regressions" };
+    std::string replay;
+};
+
+// xorshift64*
+struct Random {
+    uint64_t state;
+
+    auto Next() -> uint32_t {
+        state ^= state >> 12u;
+        state ^= state << 25u;
+        state ^= state >> 27u;
+        return static_cast<uint32_t>((state * 0x2545'F491'4F6C'DD1Dull) >> 32u);
+    }
+};
+
+// Values either side of the boundaries the microcode tests
+constexpr uint16_t EDGE_DIVISORS[] = {
+    0x0000u, 0x0001u, 0x0002u, 0x7FFEu, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFEu, 0xFFFFu,
+};
+
+constexpr uint32_t EDGE_QUOTIENTS[] = {
+    0x0000u, 0x0001u, 0x7FFEu, 0x7FFFu, 0x8000u, 0x8001u, 0xFFFEu, 0xFFFFu, 0x1'0000u,
+};
+
+auto EdgeCase(Random& random) -> Case {
+    const auto instruction = (random.Next() & 1u) ? Instruction::Divs : Instruction::Divu;
+    auto divisor = static_cast<uint16_t>(random.Next() >> 16u);
+    if (random.Next() & 1u) {
+        divisor = EDGE_DIVISORS[random.Next() % std::size(EDGE_DIVISORS)];
+    }
+    auto dividend = random.Next();
+    switch (random.Next() % 4u) {
+        case 0u: {
+            // Quotient at a boundary, with the signs of the operands chosen separately
+            const auto magnitude = static_cast<uint32_t>(static_cast<uint16_t>(divisor & 0x8000u ? -divisor : divisor));
+            const auto quotient = EDGE_QUOTIENTS[random.Next() % std::size(EDGE_QUOTIENTS)];
+            const auto remainder = (magnitude != 0u) ? random.Next() % magnitude : 0u;
+            dividend = quotient * magnitude + remainder;
+            if (instruction == Instruction::Divs && (random.Next() & 1u)) {
+                dividend = 0u - dividend;
+            }
+            break;
+        }
+        case 1u:
+            // Upper word of the dividend around the divisor, the early overflow test
+            dividend = (static_cast<uint32_t>(divisor) << 16u) + (random.Next() & 0xFFFFu) - 0x8000u;
+            break;
+        case 2u:
+            // Dividend around a sign boundary
+            dividend = (random.Next() & 1u ? 0x8000'0000u : 0u) + (random.Next() & 0xFFu) - 0x80u;
+            break;
+        default:
+            break;
+    }
+    return { instruction, dividend, divisor };
+}
+
+auto Mutate(Case c, Random& random) -> Case {
+    switch (random.Next() % 3u) {
+        case 0u:
+            c.dividend ^= 1u << (random.Next() % 32u);
+            break;
+        case 1u:
+            c.divisor ^= 1u << (random.Next() % 16u);
+            break;
+        default:
+            c.dividend += static_cast<int8_t>(random.Next());
+            break;
+    }
+    return c;
+}
+
+struct Regressions {
+    std::mutex mutex;
+    std::string path;
+    std::atomic<uint64_t> count{};
+
+    auto Save(const Case& c) -> void {
+        count.fetch_add(1u, std::memory_order_relaxed);
+        const auto minimized = Minimize(c);
+        const std::lock_guard lock(mutex);
+        std::cerr << "Mismatch: " << Format(c) << ", minimized: " << Format(minimized) << std::endl;
+        std::ofstream(path, std::ios::app) << Format(minimized) << '\n';
+    }
+};
+
+auto Fuzz(uint64_t cases, uint64_t seed, Regressions& regressions, std::atomic<uint64_t>& done) -> void {
+    Random random{ seed * 0x9E37'79B9'7F4A'7C15ull | 1u };
+    Case previous = { Instruction::Divu, 0u, 0u };
+    constexpr auto BLOCK = 1u << 16u;
+    for (auto i = uint64_t{}; i < cases; i += BLOCK) {
+        const auto block = std::min<uint64_t>(BLOCK, cases - i);
+        for (auto j = uint64_t{}; j < block; ++j) {
+            Case c;
+            switch (random.Next() % 4u) {
+                case 0u:
+                    c = { (random.Next() & 1u) ? Instruction::Divs : Instruction::Divu, random.Next(),
+                          static_cast<uint16_t>(random.Next() >> 16u) };
+                    break;
+                case 1u:
+                    c = Mutate(previous, random);
+                    break;
+                default:
+                    c = EdgeCase(random);
+                    break;
+            }
+            if (Mismatches(c)) {
+                regressions.Save(c);
+            }
+            previous = c;
+        }
+        done.fetch_add(block, std::memory_order_relaxed);
+    }
+}
+
+auto Replay(const std::string& path) -> int {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Can't read " << path << std::endl;
+        return 1;
+    }
+    auto failures = 0u;
+    auto count = 0u;
+    for (std::string line; std::getline(in, line);) {
+        std::istringstream fields(line);
+        std::string name, dividend, divisor;
+        if (!(fields >> name >> dividend >> divisor)) {
+            continue;
+        }
+        const Case c = {
+            (name == "DIVS") ? Instruction::Divs : Instruction::Divu,
+            static_cast<uint32_t>(std::stoul(dividend, nullptr, 0)),
+            static_cast<uint16_t>(std::stoul(divisor, nullptr, 0))
+        };
+        ++count;
+        if (Mismatches(c)) {
+            std::cerr << "Mismatch: " << Format(c) << std::endl;
+            ++failures;
+        }
+    }
+    std::cout << count << " cases, " << failures << " mismatches" << std::endl;
+    return (failures == 0u) ? 0 : 1;
+}
+
+auto ParseOptions(int argc, char* argv[], Options& options) -> bool {
+    for (auto i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 == argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--cases") {
+            options.cases = std::stoull(value, nullptr, 0);
+        } else if (arg == "--seed") {
+            options.seed = std::stoull(value, nullptr, 0);
+        } else if (arg == "--threads") {
+            options.threads = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+        } else if (arg == "--regressions") {
+            options.regressions = value;
+        } else if (arg == "--replay") {
+            options.replay = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    Options options;
+    try {
+        if (!ParseOptions(argc, argv, options)) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--cases N] [--seed S] [--threads T] [--regressions FILE] [--replay FILE]" << std::endl;
+            return 2;
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid option value" << std::endl;
+        return 2;
+    }
+
+    if (!options.replay.empty()) {
+        return Replay(options.replay);
+    }
+
+    Regressions regressions;
+    regressions.path = options.regressions;
+    std::atomic<uint64_t> done{};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (auto i = 0u; i < options.threads; ++i) {
+        const auto first = options.cases * i / options.threads;
+        const auto last = options.cases * (i + 1u) / options.threads;
+        threads.emplace_back(Fuzz, last - first, options.seed + i, std::ref(regressions), std::ref(done));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << done.load() << " cases in " << seconds << " s, " << static_cast<uint64_t>(static_cast<double>(done.load()) / seconds)
+              << " cases/s, " << regressions.count.load() << " mismatches" << std::endl;
+    return (regressions.count.load() == 0u) ? 0 : 1;
+}
+
+#endif
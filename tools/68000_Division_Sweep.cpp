@@ -0,0 +1,435 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "68000.h"
+#include "68000_Reference.h"
+
+// Exhaustive verification of DIVU and DIVS against the reference models.
+//
+// The input space is split into chunks of one divisor and 2^24 dividends. Each worker thread
+// starts with a contiguous range of chunks and steals half of another worker's remaining range
+// once its own runs dry, so fast divisors (overflow, division by zero) don't leave cores idle.
+//
+// Completed chunks are recorded in a bitmap that is periodically written to the checkpoint file.
+// Restarting with the same checkpoint skips the chunks already completed.
+// Mismatches are appended to a binary log of fixed size MismatchRecords. A chunk's records are written when it
+// completes, together with its bit, and the checkpoint keeps the length of the log, so a restart truncates the
+// records of the chunks it runs again. A sweep without a checkpoint starts a new log.
+
+namespace {
+
+constexpr auto DIVIDEND_CHUNK_BITS = 24u;
+constexpr auto CHUNKS_PER_DIVISOR = 1u << (32u - DIVIDEND_CHUNK_BITS);
+constexpr auto STOP_POLL_INTERVAL = 1u << 16u; // Dividends between checks of the stop flag
+
+constexpr auto INSTRUCTION_DIVU = 1u;
+constexpr auto INSTRUCTION_DIVS = 2u;
+
+constexpr char CHECKPOINT_MAGIC[8] = { '6', '8', 'K', 'S', 'W', 'E', 'E', 'P' };
+constexpr auto CHECKPOINT_VERSION = 2u;
+
+struct Options {
+    uint32_t firstDivisor{ 0u };
+    uint32_t lastDivisor{ 0xFFFFu };
+    uint32_t instructions{ INSTRUCTION_DIVU | INSTRUCTION_DIVS };
+    unsigned threads{ std::max(1u, std::thread::hardware_concurrency()) };
+    unsigned interval{ 60u }; // Seconds between checkpoints
+    std::string checkpoint{ "sweep.checkpoint" };
+    std::string mismatches{ "sweep.mismatches" };
+};
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t firstDivisor;
+    uint32_t lastDivisor;
+    uint32_t instructions;
+    uint64_t chunks;
+    uint64_t mismatchBytes; // Length of the mismatch log
+};
+
+struct MismatchRecord {
+    uint8_t instruction;
+    uint8_t reserved;
+    uint16_t divisor;
+    uint32_t dividend;
+    uint16_t expectedRemainder;
+    uint16_t expectedQuotient;
+    uint16_t actualRemainder;
+    uint16_t actualQuotient;
+    uint32_t expectedCycles;
+    uint32_t actualCycles;
+};
+
+static_assert(sizeof(MismatchRecord) == 24u);
+
+struct ChunkBitmap {
+    std::vector<std::atomic<uint64_t>> words;
+
+    explicit ChunkBitmap(uint64_t chunks) : words((chunks + 63u) / 64u) {}
+
+    auto Set(uint64_t chunk) -> void {
+        words[chunk / 64u].fetch_or(uint64_t{ 1u } << (chunk % 64u), std::memory_order_relaxed);
+    }
+
+    auto Test(uint64_t chunk) const -> bool {
+        return words[chunk / 64u].load(std::memory_order_relaxed) & (uint64_t{ 1u } << (chunk % 64u));
+    }
+
+    auto Count() const -> uint64_t {
+        auto count = uint64_t{};
+        for (const auto& word : words) {
+            count += std::popcount(word.load(std::memory_order_relaxed));
+        }
+        return count;
+    }
+};
+
+struct MismatchLog {
+    std::mutex mutex; // Guards file, bytes and the bits of completed
+    std::FILE* file{};
+    uint64_t bytes{};
+    std::atomic<uint64_t> count{};
+
+    // Writes the records of a chunk and marks it completed
+    auto Complete(uint64_t chunk, const std::vector<MismatchRecord>& records, ChunkBitmap& completed) -> void {
+        count.fetch_add(records.size(), std::memory_order_relaxed);
+        const std::lock_guard lock(mutex);
+        std::fwrite(records.data(), sizeof(MismatchRecord), records.size(), file);
+        bytes += records.size() * sizeof(MismatchRecord);
+        completed.Set(chunk);
+    }
+};
+
+// A worker's remaining chunks, the owner takes from the front and thieves take from the back
+struct WorkerRange {
+    std::mutex mutex;
+    uint64_t begin{};
+    uint64_t end{};
+};
+
+std::atomic<bool> stopRequested{};
+
+auto RequestStop(int) -> void {
+    stopRequested.store(true);
+}
+
+auto NextChunk(std::vector<std::unique_ptr<WorkerRange>>& ranges, std::size_t self, uint64_t& chunk) -> bool {
+    auto& own = *ranges[self];
+    {
+        const std::lock_guard lock(own.mutex);
+        if (own.begin < own.end) {
+            chunk = own.begin++;
+            return true;
+        }
+    }
+    for (auto i = 1u; i < ranges.size(); ++i) {
+        auto& victim = *ranges[(self + i) % ranges.size()];
+        uint64_t begin, end;
+        {
+            const std::lock_guard lock(victim.mutex);
+            if (victim.begin == victim.end) {
+                continue;
+            }
+            begin = victim.begin + (victim.end - victim.begin) / 2u;
+            end = victim.end;
+            victim.end = begin;
+        }
+        const std::lock_guard lock(own.mutex);
+        own.begin = begin + 1u;
+        own.end = end;
+        chunk = begin;
+        return true;
+    }
+    return false;
+}
+
+auto CheckDivu(uint32_t dividend, uint16_t divisor, std::vector<MismatchRecord>& mismatches) -> void {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteDivu();
+    const auto [remainder, quotient] = DivideUnsigned(dividend, divisor);
+    // The reference models don't include the exception timing, so division by zero only checks the registers
+    const auto cycles = (divisor != 0u) ? DivideUnsignedCycles(dividend, divisor) : mc68000.cycles;
+    if (mc68000.rxdh != remainder || mc68000.rxdl != quotient || mc68000.rydl != divisor || mc68000.cycles != cycles) {
+        mismatches.push_back({
+            INSTRUCTION_DIVU, 0u, divisor, dividend,
+            remainder, quotient, mc68000.rxdh, mc68000.rxdl,
+            cycles, mc68000.cycles
+        });
+    }
+}
+
+auto CheckDivs(uint32_t dividend, uint16_t divisor, std::vector<MismatchRecord>& mismatches) -> void {
+    auto mc68000 = LoadDivision(dividend, divisor);
+    mc68000.ExecuteDivs();
+    const auto [remainder, quotient] = DivideSigned(dividend, divisor);
+    const auto cycles = (divisor != 0u) ? DivideSignedCycles(dividend, divisor) : mc68000.cycles;
+    if (mc68000.rxdh != remainder || mc68000.rxdl != quotient || mc68000.rydl != divisor || mc68000.cycles != cycles) {
+        mismatches.push_back({
+            INSTRUCTION_DIVS, 0u, divisor, dividend,
+            remainder, quotient, mc68000.rxdh, mc68000.rxdl,
+            cycles, mc68000.cycles
+        });
+    }
+}
+
+// Returns false if the chunk was abandoned because a stop was requested
+auto SweepChunk(uint64_t chunk, const Options& options, MismatchLog& log, ChunkBitmap& completed,
+                std::atomic<uint64_t>& divisions) -> bool {
+    const auto divisor = static_cast<uint16_t>(options.firstDivisor + chunk / CHUNKS_PER_DIVISOR);
+    const auto base = static_cast<uint32_t>(chunk % CHUNKS_PER_DIVISOR) << DIVIDEND_CHUNK_BITS;
+    const auto perDividend = std::popcount(options.instructions);
+    std::vector<MismatchRecord> mismatches;
+    for (auto i = 0u; i < (1u << DIVIDEND_CHUNK_BITS); i += STOP_POLL_INTERVAL) {
+        if (stopRequested.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        for (auto j = i; j < i + STOP_POLL_INTERVAL; ++j) {
+            if (options.instructions & INSTRUCTION_DIVU) {
+                CheckDivu(base + j, divisor, mismatches);
+            }
+            if (options.instructions & INSTRUCTION_DIVS) {
+                CheckDivs(base + j, divisor, mismatches);
+            }
+        }
+        divisions.fetch_add(STOP_POLL_INTERVAL * perDividend, std::memory_order_relaxed);
+    }
+    log.Complete(chunk, mismatches, completed);
+    return true;
+}
+
+auto ChunkCount(const Options& options) -> uint64_t {
+    return uint64_t{ options.lastDivisor - options.firstDivisor + 1u } * CHUNKS_PER_DIVISOR;
+}
+
+// A fresh start keeps none of the mismatch log
+auto LoadCheckpoint(const Options& options, ChunkBitmap& completed, uint64_t& mismatchBytes) -> bool {
+    mismatchBytes = 0u;
+    std::ifstream in(options.checkpoint, std::ios::binary);
+    if (!in) {
+        return true; // Fresh start
+    }
+    CheckpointHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in ||
+        !std::equal(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic) ||
+        header.version != CHECKPOINT_VERSION ||
+        header.firstDivisor != options.firstDivisor ||
+        header.lastDivisor != options.lastDivisor ||
+        header.instructions != options.instructions ||
+        header.chunks != ChunkCount(options)) {
+        std::cerr << "Checkpoint " << options.checkpoint << " doesn't match the requested sweep" << std::endl;
+        return false;
+    }
+    for (auto& word : completed.words) {
+        uint64_t value{};
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        word.store(value, std::memory_order_relaxed);
+    }
+    if (!in) {
+        std::cerr << "Checkpoint " << options.checkpoint << " is truncated" << std::endl;
+        return false;
+    }
+    mismatchBytes = header.mismatchBytes;
+    return true;
+}
+
+// Written to a temporary file first, so an interruption never leaves a partial checkpoint behind
+auto SaveCheckpoint(const Options& options, const ChunkBitmap& completed, MismatchLog& log) -> void {
+    // The completed chunks and the log length from the same moment
+    std::vector<uint64_t> words;
+    uint64_t mismatchBytes;
+    {
+        const std::lock_guard lock(log.mutex);
+        std::fflush(log.file);
+        mismatchBytes = log.bytes;
+        for (const auto& word : completed.words) {
+            words.push_back(word.load(std::memory_order_relaxed));
+        }
+    }
+    const auto temporary = options.checkpoint + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        CheckpointHeader header{
+            {},
+            CHECKPOINT_VERSION,
+            options.firstDivisor,
+            options.lastDivisor,
+            options.instructions,
+            ChunkCount(options),
+            mismatchBytes
+        };
+        std::copy(std::begin(CHECKPOINT_MAGIC), std::end(CHECKPOINT_MAGIC), header.magic);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+    }
+    std::filesystem::rename(temporary, options.checkpoint);
+}
+
+auto ParseOptions(int argc, char* argv[], Options& options) -> bool {
+    for (auto i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--divisors") {
+            const auto separator = value.find(':');
+            options.firstDivisor = std::stoul(value.substr(0u, separator), nullptr, 0);
+            options.lastDivisor = (separator == std::string::npos) ?
+                options.firstDivisor :
+                std::stoul(value.substr(separator + 1u), nullptr, 0);
+        } else if (option == "--instructions") {
+            options.instructions =
+                (value == "divu") ? INSTRUCTION_DIVU :
+                (value == "divs") ? INSTRUCTION_DIVS :
+                (value == "both") ? INSTRUCTION_DIVU | INSTRUCTION_DIVS : 0u;
+        } else if (option == "--threads") {
+            options.threads = std::stoul(value, nullptr, 0);
+        } else if (option == "--interval") {
+            options.interval = std::stoul(value, nullptr, 0);
+        } else if (option == "--checkpoint") {
+            options.checkpoint = value;
+        } else if (option == "--mismatches") {
+            options.mismatches = value;
+        } else {
+            return false;
+        }
+    }
+    return options.firstDivisor <= options.lastDivisor &&
+        options.lastDivisor <= 0xFFFFu &&
+        options.instructions != 0u &&
+        options.threads != 0u &&
+        options.interval != 0u;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    Options options;
+    try {
+        if (!ParseOptions(argc, argv, options)) {
+            throw std::invalid_argument("options");
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [--divisors first[:last]] [--instructions divu|divs|both]"
+            " [--threads n] [--interval seconds] [--checkpoint file] [--mismatches file]" << std::endl;
+        return 2;
+    }
+
+    const auto chunks = ChunkCount(options);
+    ChunkBitmap completed(chunks);
+    std::error_code error;
+    const auto existingBytes = std::filesystem::exists(options.mismatches, error) ?
+        std::filesystem::file_size(options.mismatches, error) : uint64_t{};
+    if (error) {
+        std::cerr << "Unable to read " << options.mismatches << std::endl;
+        return 2;
+    }
+    auto mismatchBytes = uint64_t{};
+    if (!LoadCheckpoint(options, completed, mismatchBytes)) {
+        return 2;
+    }
+    // Drop the records of the chunks completed after the checkpoint, they run again, or of an earlier sweep
+    if (mismatchBytes > existingBytes) {
+        std::cerr << "Mismatch log " << options.mismatches << " is shorter than the checkpoint expects" << std::endl;
+        return 2;
+    }
+    if (mismatchBytes < existingBytes) {
+        std::filesystem::resize_file(options.mismatches, mismatchBytes, error);
+        if (error) {
+            std::cerr << "Unable to truncate " << options.mismatches << std::endl;
+            return 2;
+        }
+    }
+
+    MismatchLog log;
+    log.bytes = mismatchBytes;
+    log.file = std::fopen(options.mismatches.c_str(), "ab");
+    if (!log.file) {
+        std::cerr << "Unable to open " << options.mismatches << std::endl;
+        return 2;
+    }
+
+    std::signal(SIGINT, RequestStop);
+    std::signal(SIGTERM, RequestStop);
+
+    std::vector<std::unique_ptr<WorkerRange>> ranges;
+    for (auto i = 0u; i < options.threads; ++i) {
+        auto range = std::make_unique<WorkerRange>();
+        range->begin = chunks * i / options.threads;
+        range->end = chunks * (i + 1u) / options.threads;
+        ranges.push_back(std::move(range));
+    }
+
+    std::atomic<uint64_t> divisions{};
+    std::atomic<unsigned> running{ options.threads };
+    std::vector<std::thread> workers;
+    for (auto i = 0u; i < options.threads; ++i) {
+        workers.emplace_back([&, i] {
+            uint64_t chunk;
+            while (NextChunk(ranges, i, chunk)) {
+                if (completed.Test(chunk)) {
+                    continue;
+                }
+                if (!SweepChunk(chunk, options, log, completed, divisions)) {
+                    break;
+                }
+            }
+            running.fetch_sub(1u);
+        });
+    }
+
+    std::cout << "Sweeping divisors " << options.firstDivisor << " to " << options.lastDivisor
+        << " on " << options.threads << " threads, "
+        << completed.Count() << " of " << chunks << " chunks already complete" << std::endl;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+    auto lastDivisions = uint64_t{};
+    while (running.load() != 0u) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastReport < std::chrono::seconds(options.interval)) {
+            continue;
+        }
+        const auto total = divisions.load();
+        const auto seconds = std::chrono::duration<double>(now - lastReport).count();
+        SaveCheckpoint(options, completed, log);
+        std::cout << completed.Count() << "/" << chunks << " chunks, "
+            << static_cast<uint64_t>((total - lastDivisions) / seconds) << " divisions/s, "
+            << log.count.load() << " mismatches" << std::endl;
+        lastReport = now;
+        lastDivisions = total;
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    SaveCheckpoint(options, completed, log);
+    std::fclose(log.file);
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto finished = completed.Count();
+    std::cout << (finished == chunks ? "Sweep complete: " : "Sweep interrupted: ")
+        << finished << "/" << chunks << " chunks, "
+        << divisions.load() << " divisions in " << seconds << " s ("
+        << static_cast<uint64_t>(divisions.load() / seconds) << " divisions/s), "
+        << log.count.load() << " mismatches" << std::endl;
+
+    return log.count.load() == 0u ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "68000.h"
+#include "68000_TraceFile.h"
+
+// Records, replays, compares and converts binary microcycle traces.
+//
+//     68000_Division_Trace record OUT [COUNT] [SEED]   Appends the traces of COUNT random DIVU and DIVS
+//     68000_Division_Trace replay IN [FIRST] [COUNT]   Prints the records
+//     68000_Division_Trace diff A B                    Prints the first differences, exits with 1 if any
+//     68000_Division_Trace vcd IN OUT                  Writes a value change dump for waveform viewers
+//
+// Traces are read through MappedTrace, so replaying or comparing large traces doesn't load them.
+
+namespace {
+
+constexpr auto DIFF_LIMIT = 16u; // Differences printed before diff gives up
+
+auto Print(std::size_t index, const MicrocycleRecord& record) -> void {
+    std::printf("%10zu %-6s alu=%04X alue=%04X alub=%04X au=%08X ath=%04X atl=%04X flags=%02X cycles=%u\n",
+                index,
+                (record.microword < MICROWORD_COUNT) ? MICROWORD_NAMES[record.microword] : "?",
+                record.alu, record.alue, record.alub, static_cast<unsigned>(record.au), record.ath, record.atl,
+                record.flags, static_cast<unsigned>(record.cycles));
+}
+
+auto Record(const std::string& path, uint64_t count, uint64_t seed) -> int {
+    BinaryTraceSink sink;
+    if (!sink.Open(path)) {
+        return 1;
+    }
+    std::mt19937_64 random(seed);
+    for (uint64_t i = 0u; i < count; ++i) {
+        const auto value = random();
+        MC68000 mc68000;
+        mc68000.rxdh = static_cast<uint16_t>(value >> 16u);
+        mc68000.rxdl = static_cast<uint16_t>(value);
+        mc68000.rydl = static_cast<uint16_t>(value >> 32u);
+        if ((value >> 48u) & 1u) {
+            mc68000.microword = DVS01;
+            mc68000.ExecuteDivs(sink);
+        } else {
+            mc68000.microword = DVUR1;
+            mc68000.ExecuteDivu(sink);
+        }
+    }
+    if (!sink.Close()) {
+        std::cerr << "Can't write trace " << path << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+auto Replay(const std::string& path, uint64_t first, uint64_t count) -> int {
+    MappedTrace trace;
+    if (!trace.Open(path)) {
+        return 1;
+    }
+    for (auto i = first; i < trace.Size() && i - first < count; ++i) {
+        Print(i, trace[i]);
+    }
+    return 0;
+}
+
+auto Diff(const std::string& pathA, const std::string& pathB) -> int {
+    MappedTrace a, b;
+    if (!a.Open(pathA) || !b.Open(pathB)) {
+        return 2;
+    }
+    auto differences = 0u;
+    const auto size = std::min(a.Size(), b.Size());
+    for (std::size_t i = 0u; i < size && differences < DIFF_LIMIT; ++i) {
+        const auto& x = a[i];
+        const auto& y = b[i];
+        if (x.microword != y.microword || x.alu != y.alu || x.alue != y.alue || x.alub != y.alub ||
+            x.atl != y.atl || x.ath != y.ath || x.flags != y.flags || x.au != y.au || x.cycles != y.cycles) {
+            std::printf("< ");
+            Print(i, x);
+            std::printf("> ");
+            Print(i, y);
+            ++differences;
+        }
+    }
+    if (a.Size() != b.Size()) {
+        std::printf("%s has %zu records, %s has %zu\n", pathA.c_str(), a.Size(), pathB.c_str(), b.Size());
+        ++differences;
+    }
+    return (differences == 0u) ? 0 : 1;
+}
+
+auto Vcd(const std::string& in, const std::string& out) -> int {
+    MappedTrace trace;
+    if (!trace.Open(in)) {
+        return 1;
+    }
+    std::ofstream vcd(out);
+    if (!vcd) {
+        std::cerr << "Can't open " << out << std::endl;
+        return 1;
+    }
+
+    struct Signal {
+        const char* name;
+        unsigned width;
+        char id;
+        uint32_t (*value)(const MicrocycleRecord&);
+    };
+    static constexpr Signal SIGNALS[] = {
+        { "microword", 6u, '!', [](const MicrocycleRecord& r) -> uint32_t { return r.microword; } },
+        { "alu", 16u, '"', [](const MicrocycleRecord& r) -> uint32_t { return r.alu; } },
+        { "alue", 16u, '#', [](const MicrocycleRecord& r) -> uint32_t { return r.alue; } },
+        { "alub", 16u, '$', [](const MicrocycleRecord& r) -> uint32_t { return r.alub; } },
+        { "au", 32u, '%', [](const MicrocycleRecord& r) -> uint32_t { return r.au; } },
+        { "ath", 16u, '&', [](const MicrocycleRecord& r) -> uint32_t { return r.ath; } },
+        { "atl", 16u, '\'', [](const MicrocycleRecord& r) -> uint32_t { return r.atl; } },
+        { "flags", 5u, '(', [](const MicrocycleRecord& r) -> uint32_t { return r.flags; } },
+        { "cycles", 32u, ')', [](const MicrocycleRecord& r) -> uint32_t { return r.cycles; } },
+    };
+
+    vcd << "$comment 68000 division microcycle trace, microword numbers:";
+    for (auto i = 0u; i < MICROWORD_COUNT; ++i) {
+        vcd << ' ' << i << '=' << MICROWORD_NAMES[i];
+    }
+    vcd << " $end\n$timescale 1 ns $end\n$scope module mc68000 $end\n";
+    for (const auto& signal : SIGNALS) {
+        vcd << "$var reg " << signal.width << ' ' << signal.id << ' ' << signal.name << " $end\n";
+    }
+    vcd << "$upscope $end\n$enddefinitions $end\n";
+
+    // One microword takes two clocks, only the values that changed are written
+    const auto write = [&](const Signal& signal, uint32_t value) {
+        vcd << 'b';
+        for (auto bit = signal.width; bit-- > 0u;) {
+            vcd << (((value >> bit) & 1u) ? '1' : '0');
+        }
+        vcd << ' ' << signal.id << '\n';
+    };
+    for (std::size_t i = 0u; i < trace.Size(); ++i) {
+        vcd << '#' << i * 2u << '\n';
+        for (const auto& signal : SIGNALS) {
+            const auto value = signal.value(trace[i]);
+            if (i == 0u || value != signal.value(trace[i - 1u])) {
+                write(signal, value);
+            }
+        }
+    }
+    vcd << '#' << trace.Size() * 2u << '\n';
+    return vcd ? 0 : 1;
+}
+
+}
+
+auto main(int argc, char* argv[]) -> int {
+    const std::string command = (argc > 1) ? argv[1] : "";
+    try {
+        if (command == "record" && argc >= 3 && argc <= 5) {
+            return Record(argv[2], (argc > 3) ? std::stoull(argv[3], nullptr, 0) : 1000u,
+                          (argc > 4) ? std::stoull(argv[4], nullptr, 0) : 1u);
+        }
+        if (command == "replay" && argc >= 3 && argc <= 5) {
+            return Replay(argv[2], (argc > 3) ? std::stoull(argv[3], nullptr, 0) : 0u,
+                          (argc > 4) ? std::stoull(argv[4], nullptr, 0) : UINT64_MAX);
+        }
+        if (command == "diff" && argc == 4) {
+            return Diff(argv[2], argv[3]);
+        }
+        if (command == "vcd" && argc == 4) {
+            return Vcd(argv[2], argv[3]);
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid argument" << std::endl;
+        return 2;
+    }
+    std::cerr << "Usage: " << argv[0] << " record OUT [COUNT] [SEED]\n"
+              << "       " << argv[0] << " replay IN [FIRST] [COUNT]\n"
+              << "       " << argv[0] << " diff A B\n"
+              << "       " << argv[0] << " vcd IN OUT" << std::endl;
+    return 2;
+}